@@ -5,24 +5,82 @@
  * This program runs exhaustive enumeration of Hamiltonian paths/tours under
  * specific disjointness and cost constraints. It implements the exhaustive search 
  * analysis used to support Observations 1 and 4 in the paper.
+ *
+ * Each family of queries is answered by an incremental sweep over n (see incremental_sweep.h),
+ * and answers are stored in a local result cache (see result_cache.h), so re-running the
+ * verification is instant. Use --cache <file> to change its location, or --no-cache
+ * to always recompute. With --certify <dir>, every negative claim is also backed by an
+ * infeasibility certificate written to <dir>, to be validated by check_certificate.
+ * With --matrix <file> or --tsplib <file>, the minimum-cost disjoint pairs of paths and cycles
+ * under that distance matrix are reported instead (see distance_matrix.h); add --directed for
+ * arc-disjoint directed tours, under possibly asymmetric distances.
+ * --huge-pages <off|transparent|explicit> chooses how the large tour tables are mapped (see
+ * huge_pages.h), and --memory-stats prints how much of them was backed by huge pages. Only tables
+ * of at least one huge page take that path, so both flags only matter in matrix and server mode:
+ * the tables of the Observation searches (n <= 8) are far smaller, and the statistics report 0
+ * large tables for them.
+ * With --serve (standard input / output) or --socket <path> (Unix domain socket), main instead
+ * stays up and answers queries from warm tables and caches (see query_server.h); --threads <k>
+ * sets the size of its worker pool.
  */
 
 #include <iostream>
+#include <string>
+#include <cstdlib>
 #include <cassert>
 #include <hamiltonian_paths.h>
 #include <hamiltonian_cycles.h>
+#include <result_cache.h>
+#include <incremental_sweep.h>
+#include <certificate.h>
+#include <distance_matrix.h>
+#include <huge_pages.h>
+#include <session.h>
+#include <query_server.h>
+
+// Cache file used by the tests below. An empty name disables caching.
+static std::string cacheFile = DEFAULT_CACHE_FILE;
+
+// Directory receiving infeasibility certificates. An empty name disables certificates.
+static std::string certificateDir = "";
+
+// Set when a certificate could not be written, so that main exits with an error.
+static bool certificateFailed = false;
+
+/**
+ * @brief Writes the certificate of a negative claim, if certificates are enabled.
+ * @param topology "line" or "circle".
+ * @param n Number of vertices.
+ * @param requireOddDepth Whether the claim is about odd-depth cycles.
+ * @param bound Strict upper bound on the total cost of the pair.
+ * A certificate that cannot be written is reported on standard error, and makes main return 1.
+ */
+void certify(const std::string& topology, const int n, const bool requireOddDepth, const Bound& bound){
+    if (certificateDir.empty()) return;
+    std::string filename = certificateDir + "/" + topology + (requireOddDepth ? "_odd" : "") + "_n" + std::to_string(n)
+                           + "_" + std::to_string(bound.numerator) + "_" + std::to_string(bound.denominator) + ".podc";
+    if (!writeInfeasibilityCertificate(filename, topology, n, requireOddDepth, bound)){
+        std::cerr << "Cannot write certificate " << filename << ".\n";
+        certificateFailed = true;
+        return;
+    }
+    std::cout << "\tCertificate written to " << filename << "\n";
+}
 
 /**
  * @brief Verifies existence of edge-disjoint Hamiltonian (s, t)-paths for small n.
  */
 int testDisjointPathsExist(){
-    assert(!disjointPathsExist(3));
-    assert(!disjointPathsExist(4));
-    assert(!disjointPathsExist(5));
+    std::vector<QueryResult> results = sweepDisjointPaths(cacheFile, 3, 8);
 
-    assert(disjointPathsExist(6));
-    assert(disjointPathsExist(7));
-    assert(disjointPathsExist(8));
+    assert(!results.at(3 - 3).exists);
+    assert(!results.at(4 - 3).exists);
+    assert(!results.at(5 - 3).exists);
+    for (int n = 3; n <= 5; n++) certify("line", n, false, Bound(n * n + 1));      // Every pair costs at most n^2.
+
+    assert(results.at(6 - 3).exists);
+    assert(results.at(7 - 3).exists);
+    assert(results.at(8 - 3).exists);
 
     return 0;
 }
@@ -31,13 +89,18 @@ int testDisjointPathsExist(){
  * @brief Verifies cost-bounded existence of edge-disjoint Hamiltonian (s, t)-paths for small n.
  */
 int testDisjointPathsExistWithinBound(){
-    assert(!disjointPathsExistWithinBound(6, 16.0 * (6 - 1) / 5.0));
-    assert(!disjointPathsExistWithinBound(7, 16.0 * (7 - 1) / 5.0));
-    assert(!disjointPathsExistWithinBound(8, 16.0 * (8 - 1) / 5.0));
+    std::vector<Bound> lowBounds{Bound(16 * (6 - 1), 5), Bound(16 * (7 - 1), 5), Bound(16 * (8 - 1), 5)};
+    std::vector<QueryResult> lowResults = sweepDisjointPathsWithinBound(cacheFile, 6, 8, lowBounds);
+    assert(!lowResults.at(6 - 6).exists);
+    assert(!lowResults.at(7 - 6).exists);
+    assert(!lowResults.at(8 - 6).exists);
+    for (int n = 6; n <= 8; n++) certify("line", n, false, lowBounds.at(n - 6));
 
-    assert(disjointPathsExistWithinBound(6, 4.0 * (6 - 1)));
-    assert(disjointPathsExistWithinBound(7, 4.0 * (7 - 1)));
-    assert(disjointPathsExistWithinBound(8, 4.0 * (8 - 1)));
+    std::vector<Bound> highBounds{Bound(4 * (6 - 1)), Bound(4 * (7 - 1)), Bound(4 * (8 - 1))};
+    std::vector<QueryResult> highResults = sweepDisjointPathsWithinBound(cacheFile, 6, 8, highBounds);
+    assert(highResults.at(6 - 6).exists);
+    assert(highResults.at(7 - 6).exists);
+    assert(highResults.at(8 - 6).exists);
 
     return 0;
 }
@@ -46,13 +109,16 @@ int testDisjointPathsExistWithinBound(){
  * @brief Verifies existence of edge-disjoint Hamiltonian cycles for small n.
  */
 int testDisjointCyclesExist(){
-    assert(!disjointCyclesExist(3));
-    assert(!disjointCyclesExist(4));
+    std::vector<QueryResult> results = sweepDisjointCycles(cacheFile, 3, 8);
+
+    assert(!results.at(3 - 3).exists);
+    assert(!results.at(4 - 3).exists);
+    for (int n = 3; n <= 4; n++) certify("circle", n, false, Bound(n * n + 1));    // Every pair costs at most n^2.
 
-    assert(disjointCyclesExist(5));
-    assert(disjointCyclesExist(6));
-    assert(disjointCyclesExist(7));
-    assert(disjointCyclesExist(8));
+    assert(results.at(5 - 3).exists);
+    assert(results.at(6 - 3).exists);
+    assert(results.at(7 - 3).exists);
+    assert(results.at(8 - 3).exists);
 
     return 0;
 }
@@ -61,23 +127,117 @@ int testDisjointCyclesExist(){
  * @brief Verifies cost-bounded existence of edge-disjoint Hamiltonian cycles for small n.
  */
 int testDisjointCyclesExistWithinBound(){
-    assert(!disjointCyclesExistWithinBound(5, 16.0 * 5 / 5.0));
-    assert(!disjointCyclesExistWithinBound(6, 16.0 * 6 / 5.0));
-    assert(!disjointCyclesExistWithinBound(7, 16.0 * 7 / 5.0));
-    assert(!disjointCyclesExistWithinBound(8, 16.0 * 8 / 5.0));
+    std::vector<Bound> lowBounds{Bound(16 * 5, 5), Bound(16 * 6, 5), Bound(16 * 7, 5), Bound(16 * 8, 5)};
+    std::vector<QueryResult> lowResults = sweepDisjointCyclesWithinBound(cacheFile, 5, 8, lowBounds);
+    assert(!lowResults.at(5 - 5).exists);
+    assert(!lowResults.at(6 - 5).exists);
+    assert(!lowResults.at(7 - 5).exists);
+    assert(!lowResults.at(8 - 5).exists);
+    for (int n = 5; n <= 8; n++) certify("circle", n, true, lowBounds.at(n - 5));
 
-    // assert(disjointCyclesExistWithinBound(5, 4.0 * 5));  // There are no odd-depth disjoint tours for n = 5
-    assert(disjointCyclesExistWithinBound(6, 4.0 * 6));
-    assert(disjointCyclesExistWithinBound(7, 4.0 * 7));
-    assert(disjointCyclesExistWithinBound(8, 4.0 * 8));
+    std::vector<Bound> highBounds{Bound(4 * 5), Bound(4 * 6), Bound(4 * 7), Bound(4 * 8)};
+    std::vector<QueryResult> highResults = sweepDisjointCyclesWithinBound(cacheFile, 5, 8, highBounds);
+    // assert(highResults.at(5 - 5).exists);  // There are no odd-depth disjoint tours for n = 5
+    assert(highResults.at(6 - 5).exists);
+    assert(highResults.at(7 - 5).exists);
+    assert(highResults.at(8 - 5).exists);
 
     return 0;
 }
 
+/**
+ * @brief Reports the minimum-cost disjoint pairs of (1, n)-paths and of cycles under a distance matrix.
+ * @param directed Report arc-disjoint directed tours instead.
+ */
+int reportDistanceMatrix(const DistanceMatrix& matrix, const bool directed){
+    std::cout << "Distance matrix on n = " << matrix.n << " vertices" << (directed ? " (directed)" : "") << ":\n";
+    for (bool closed : {false, true}){
+        std::vector<int> witness1, witness2;
+        long long cost = directed ? minArcDisjointToursInMatrix(matrix, closed, witness1, witness2)
+                                  : minDisjointToursInMatrix(matrix, closed, witness1, witness2);
+        std::cout << "\t" << (closed ? "Cycles" : "(1, n)-paths") << ": ";
+        if (cost < 0){
+            std::cout << (directed ? "no arc-disjoint pair.\n" : "no edge-disjoint pair.\n");
+            continue;
+        }
+        std::cout << "minimum total cost " << cost << ", e.g.";
+        for (const std::vector<int>* tour : {&witness1, &witness2}){
+            std::cout << " (";
+            for (int k = 0; k < (int) tour->size(); k++) std::cout << (k > 0 ? " " : "") << tour->at(k);
+            std::cout << ")";
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
+
 /**
  * @brief Program terminates successfully only if all tests pass, thereby validating the stated observations. 
  */
-int main() {
+int main(int argc, char* argv[]) {
+    std::string matrixOption, matrixFile;
+    bool directed{false};
+    bool memoryStats{false};
+    bool serve{false};
+    std::string socketPath;
+    int threads{0};
+    for (int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if (arg == "--no-cache") cacheFile = "";
+        else if (arg == "--cache" && i + 1 < argc) cacheFile = argv[++i];
+        else if (arg == "--certify" && i + 1 < argc) certificateDir = argv[++i];
+        else if ((arg == "--matrix" || arg == "--tsplib") && i + 1 < argc){
+            matrixOption = arg;
+            matrixFile = argv[++i];
+        }
+        else if (arg == "--directed") directed = true;
+        else if (arg == "--memory-stats") memoryStats = true;
+        else if (arg == "--serve") serve = true;
+        else if (arg == "--socket" && i + 1 < argc) socketPath = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (arg == "--huge-pages" && i + 1 < argc){
+            HugePagePolicy policy;
+            if (!parseHugePagePolicy(argv[++i], policy)){
+                std::cerr << "Unknown huge page policy " << argv[i] << " (expected off, transparent or explicit).\n";
+                return 1;
+            }
+            setHugePagePolicy(policy);
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--cache <file> | --no-cache] [--certify <dir>]"
+                      << " [--matrix <file> | --tsplib <file>] [--directed]"
+                      << " [--huge-pages <off|transparent|explicit>] [--memory-stats]"
+                      << " [--serve | --socket <path>] [--threads <k>]\n";
+            return 1;
+        }
+    }
+
+    if (serve || !socketPath.empty()){
+        SessionOptions options;
+        options.threads = threads;
+        options.cacheFile = cacheFile;
+        Session session(options);
+        if (serve) return serveStream(session, std::cin, std::cout);
+        int status = serveUnixSocket(session, socketPath);
+        if (status != 0) std::cerr << "Cannot listen on " << socketPath << ".\n";
+        return status;
+    }
+
+    if (!matrixFile.empty()){
+        DistanceMatrix matrix;
+        bool read = (matrixOption == "--matrix") ? readDistanceMatrix(matrixFile, matrix, !directed)
+                                                 : readTsplibInstance(matrixFile, matrix);
+        const int maxN = directed ? 11 : 12;
+        if (!read || matrix.n > maxN || (!directed && !isValidDistanceMatrix(matrix))){
+            std::cerr << "Cannot use " << matrixFile << ": not a valid" << (directed ? "" : " symmetric")
+                      << " distance matrix on at most " << maxN << " vertices.\n";
+            return 1;
+        }
+        int status = reportDistanceMatrix(matrix, directed);
+        if (memoryStats) std::cout << hugePageStatsLine(hugePageStats()) << "\n";
+        return status;
+    }
+
     // Proof of Observation 1
     std::cout << "Proof of Observation 1:\n";
     testDisjointPathsExist();
@@ -94,5 +254,6 @@ int main() {
     std::cout << "\t(ii) There is no pair of (odd-depth) edge-disjoint Hamiltonian cycles with total cost less than 16*n/5 when n in {5, 6, 7, 8}.\n";
     std::cout << "\n";
 
-    return 0;
+    if (memoryStats) std::cout << hugePageStatsLine(hugePageStats()) << "\n";
+    return certificateFailed ? 1 : 0;
 }
@@ -0,0 +1,56 @@
+/**
+ * @file overlap_matrix.cpp
+ * @brief Standalone tool printing the number of edges shared by every pair of a tour pool.
+ *
+ * The pool is read from a text file with one tour per line (see readTourPoolText in
+ * tour_stream.h), and the matrix is built through an edge index (see tour_overlap.h). The
+ * program links only the pool reader and the overlap code.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tour_stream.h>
+#include <tour_overlap.h>
+
+/**
+ * @brief Prints the overlap matrix of a pool (one row per tour), or its disjoint pairs with
+ * --disjoint, after a summary line starting with '#'. Tours are cycles unless --line is given.
+ */
+int main(int argc, char* argv[]){
+    bool closed{true};
+    bool disjointOnly{false};
+    std::string poolFile;
+    for (int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if (arg == "--line") closed = false;
+        else if (arg == "--disjoint") disjointOnly = true;
+        else if (poolFile.empty() && arg.compare(0, 2, "--") != 0) poolFile = arg;
+        else poolFile = "";
+    }
+    std::vector<std::vector<int>> tours;
+    if (poolFile.empty() || !readTourPoolText(poolFile, tours)){
+        std::cerr << "Usage: " << argv[0] << " [--line] [--disjoint] <pool>\n"
+                  << "where <pool> is a readable text file with one tour per line.\n";
+        return 1;
+    }
+
+    OverlapMatrix matrix = computeOverlapMatrix(tours, closed);
+    long long disjointPairs{0};
+    for (int i = 0; i < matrix.tours; i++){
+        for (int j = i + 1; j < matrix.tours; j++) disjointPairs += (matrix.at(i, j) == 0);
+    }
+    std::cout << "# " << matrix.tours << " tours, " << matrix.distinctEdges << " distinct edges, "
+              << matrix.pairUpdates << " pair updates, " << disjointPairs << " edge-disjoint pairs\n";
+    for (int i = 0; i < matrix.tours; i++){
+        if (disjointOnly){
+            for (int j = i + 1; j < matrix.tours; j++){
+                if (matrix.at(i, j) == 0) std::cout << i << " " << j << "\n";
+            }
+            continue;
+        }
+        for (int j = 0; j < matrix.tours; j++) std::cout << (j > 0 ? " " : "") << matrix.at(i, j);
+        std::cout << "\n";
+    }
+    return 0;
+}
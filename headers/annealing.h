@@ -0,0 +1,59 @@
+/**
+ * @file annealing.h
+ * @brief Declarations for a parallel tempering optimizer over pairs of edge-disjoint tours.
+ *
+ * Several replicas of a disjoint pair are annealed at different temperatures, each on its own
+ * thread, and neighbouring temperatures are swapped between epochs. Moves are evaluated and
+ * applied in O(1), so n can go up to several thousand. The result is an upper bound on the
+ * minimum total cost, to be compared with 2 OPT (2(n - 1) on the line, 2n on the circle).
+ */
+
+#ifndef ANNEALING_H
+#define ANNEALING_H
+
+#include <vector>
+
+/**
+ * @brief Parameters of a parallel tempering run.
+ *        Temperatures are spaced geometrically between minTemperature and maxTemperature.
+ */
+struct AnnealingOptions {
+    int replicas;
+    int epochs;
+    long long movesPerEpoch;
+    double minTemperature;
+    double maxTemperature;
+    unsigned seed;
+};
+
+/**
+ * @brief Reasonable default parameters for a given n.
+ * @param n Number of vertices.
+ * @return Options with one replica per hardware thread (at least 2) and n-proportional epochs.
+ */
+AnnealingOptions defaultAnnealingOptions(const int n);
+
+/**
+ * @brief Minimizes the total cost of two edge-disjoint paths (endpoints 1 and n).
+ * @param n Number of vertices, n >= 6.
+ * @param options Parameters of the run.
+ * @param witness1 Output: first path of the best pair found.
+ * @param witness2 Output: second path of the best pair found.
+ * @return Total cost of the best pair found.
+ */
+long long annealDisjointPaths(const int n, const AnnealingOptions& options,
+                              std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Minimizes the total cost of two edge-disjoint cycles.
+ * @param n Number of vertices, n >= 8.
+ * @param options Parameters of the run.
+ * @param requireOddDepth If true, only odd-depth pairs are visited.
+ * @param witness1 Output: first cycle of the best pair found, in canonical form.
+ * @param witness2 Output: second cycle of the best pair found, in canonical form.
+ * @return Total cost of the best pair found.
+ */
+long long annealDisjointCycles(const int n, const AnnealingOptions& options, const bool requireOddDepth,
+                               std::vector<int>& witness1, std::vector<int>& witness2);
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file anytime_search.h
+ * @brief Declarations for a budgeted, resumable search for the minimum-cost disjoint pair.
+ *
+ * The exact search visits tour pairs in increasing order of their smaller tour cost, and
+ * prunes every pair that cannot beat the best pair found so far. When its node or time budget
+ * runs out it stops with the best pair and a proven lower bound on the optimum, and it can be
+ * resumed later from the same state, so the gap can be narrowed within fixed time slots.
+ */
+
+#ifndef ANYTIME_SEARCH_H
+#define ANYTIME_SEARCH_H
+
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Limits of one call to continueAnytimeSearch(). Non-positive values mean no limit.
+ */
+struct SearchBudget {
+    long long maxNodes;
+    double maxSeconds;
+};
+
+/**
+ * @brief State of an anytime search, to be created by startAnytimePathSearch() or
+ *        startAnytimeCycleSearch() and advanced by continueAnytimeSearch().
+ *
+ * bestCost is -1 while no disjoint pair is known. Every disjoint pair costs at least
+ * lowerBound (LLONG_MAX once the search proves that there is none). When complete is true,
+ * lowerBound equals bestCost, or there is no disjoint pair.
+ * The tours, sorted by cost, are held in tables (the PairEngine of the topology, see
+ * anytime_search.cpp), which are never modified, so copies of a search share them.
+ */
+struct AnytimeTables;
+
+struct AnytimeSearch {
+    bool closed;
+    int n;
+    std::shared_ptr<const AnytimeTables> tables;
+    std::vector<int> costs;
+    long long outer;
+    long long inner;
+    long long nodes;
+    long long bestCost;
+    std::vector<int> witness1;
+    std::vector<int> witness2;
+    long long lowerBound;
+    bool complete;
+};
+
+/**
+ * @brief Prepares a search over the Hamiltonian paths with endpoints 1 and n.
+ * @param n Number of vertices, n >= 2.
+ * @return A search state with no node examined yet.
+ */
+AnytimeSearch startAnytimePathSearch(const int n);
+
+/**
+ * @brief Prepares a search over the Hamiltonian cycles.
+ * @param n Number of vertices, n >= 3.
+ * @param requireOddDepth If true, only odd-depth cycles are considered.
+ * @return A search state with no node examined yet.
+ */
+AnytimeSearch startAnytimeCycleSearch(const int n, const bool requireOddDepth);
+
+/**
+ * @brief Provides an upper bound from a known disjoint pair (e.g. a construction or heuristic).
+ *        The pair is kept only if it is cheaper than the best pair so far.
+ * @param search Search state.
+ * @param tour1 First tour of the pair.
+ * @param tour2 Second tour of the pair, edge-disjoint from the first.
+ */
+void seedAnytimeSearch(AnytimeSearch& search, const std::vector<int>& tour1, const std::vector<int>& tour2);
+
+/**
+ * @brief Advances the search until it completes or the budget of this call is spent.
+ * @param search Search state, updated in place.
+ * @param budget Node (pair tests) and time limits for this call.
+ * @return true if the search is complete, false if the budget ran out first.
+ */
+bool continueAnytimeSearch(AnytimeSearch& search, const SearchBudget& budget);
+
+#endif
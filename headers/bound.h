@@ -0,0 +1,65 @@
+/**
+ * @file bound.h
+ * @brief Declaration of the exact rational cost bound used by all *WithinBound functions.
+ *
+ * Bounds such as 16(n - 1)/5 are kept as a reduced fraction p/q, so comparisons against
+ * integer costs are exact (cost * q < p) and bounds can be used verbatim as cache keys.
+ */
+
+#ifndef BOUND_H
+#define BOUND_H
+
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Largest |p| and q accepted by Bound. In this range, maxAdmissibleCost() cannot overflow,
+ * and so admits() is exact for every long long cost. Callers parsing untrusted bounds (such as
+ * the query server) must reject values outside of it.
+ */
+constexpr long long BOUND_MAX = 1LL << 62;
+
+/**
+ * @brief Strict upper bound p/q on a (total) cost, with q > 0 and gcd(p, q) = 1.
+ */
+struct Bound {
+    long long numerator;
+    long long denominator;
+
+    /**
+     * @brief Builds the bound p/q, normalized to lowest terms with a positive denominator.
+     * @param p Numerator, with |p| <= BOUND_MAX.
+     * @param q Denominator, non-zero, with |q| <= BOUND_MAX.
+     */
+    explicit Bound(long long p, long long q = 1);
+
+    /**
+     * Floating-point bounds such as 25.6 would be truncated to an integer: they must be written
+     * as exact fractions (Bound(128, 5)), so these conversions do not compile.
+     */
+    template <class P, class Q = long long,
+              class = typename std::enable_if<std::is_floating_point<P>::value || std::is_floating_point<Q>::value>::type>
+    Bound(P p, Q q = 1) = delete;
+
+    /**
+     * @brief Tests whether an integer cost is strictly below the bound.
+     * @param cost The cost.
+     * @return true if cost < p/q, false otherwise.
+     */
+    bool admits(long long cost) const;
+
+    /**
+     * @brief Largest integer cost strictly below the bound, i.e. ceil(p/q) - 1.
+     * @return The integer threshold; a cost c is admitted if and only if c <= threshold.
+     */
+    long long maxAdmissibleCost() const;
+
+    /**
+     * @brief Exact textual form "p/q".
+     */
+    std::string toString() const;
+
+    bool operator==(const Bound& other) const;
+};
+
+#endif
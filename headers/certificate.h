@@ -0,0 +1,62 @@
+/**
+ * @file certificate.h
+ * @brief Declarations for infeasibility certificates and their independent checker.
+ *
+ * The negative claims (no disjoint pair below a bound) are otherwise only backed by running
+ * the search. A certificate records the pruning decisions of a depth-first enumeration of the
+ * tours (which subtree was cut, and the bound used) and, for every remaining pair of tours
+ * within the bound, the position of an edge they share. The checker replays the enumeration,
+ * validates each pruning bound and tests each shared edge in O(1), so it runs much faster
+ * than the search and shares no code with it.
+ *
+ * Format: "PODC" | uint32 version | uint8 closed | uint8 oddDepth | uint32 n | int64 p | int64 q
+ *         | uint64 treeBytes | tree tokens | uint64 tours | uint64 pairs | one uint8 per pair.
+ * Tree tokens: for every candidate child of every explored prefix, in increasing label order,
+ * 1 if it is explored, or 0 followed by a LEB128 lower bound on the total cost of any pair
+ * using a tour of that subtree.
+ */
+
+#ifndef CERTIFICATE_H
+#define CERTIFICATE_H
+
+#include <string>
+#include <bound.h>
+
+/**
+ * @brief Outcome of checking a certificate. The claim is "no pair of edge-disjoint tours
+ *        (odd-depth cycles if oddDepth) on n vertices has total cost < numerator/denominator".
+ */
+struct CertificateReport {
+    bool valid;
+    std::string error;
+    std::string topology;
+    int n;
+    bool oddDepth;
+    long long numerator;
+    long long denominator;
+    long long tours;
+    long long pairs;
+    long long prunedSubtrees;
+};
+
+/**
+ * @brief Searches for an edge-disjoint pair below the bound and, if there is none, writes a
+ *        certificate of that fact.
+ * @param filename Destination file (overwritten).
+ * @param topology "line" (paths with endpoints 1 and n) or "circle" (cycles).
+ * @param n Number of vertices, 3 <= n <= 255.
+ * @param requireOddDepth If true, only odd-depth cycles are considered (circle only).
+ * @param bound Strict upper bound on the total cost of the pair.
+ * @return true if the certificate was written, false if a disjoint pair exists or on I/O error.
+ */
+bool writeInfeasibilityCertificate(const std::string& filename, const std::string& topology, const int n,
+                                   const bool requireOddDepth, const Bound& bound);
+
+/**
+ * @brief Validates a certificate without running the search.
+ * @param filename Certificate file.
+ * @return The claim and its statistics, with valid set only if every step checks out.
+ */
+CertificateReport checkInfeasibilityCertificate(const std::string& filename);
+
+#endif
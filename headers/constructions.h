@@ -0,0 +1,50 @@
+/**
+ * @file constructions.h
+ * @brief Declarations for explicit constructions of edge-disjoint tour pairs for arbitrary n.
+ *
+ * The exhaustive engines stop at small n; these generators build, in linear time, disjoint
+ * pairs whose total cost is 16(n - 1)/5 + O(1) on the line and 16n/5 + O(1) on the circle.
+ * They give upper bounds for n up to millions and can be written out in the witness format
+ * of tour_stream.h.
+ */
+
+#ifndef CONSTRUCTIONS_H
+#define CONSTRUCTIONS_H
+
+#include <vector>
+#include <string>
+
+/**
+ * @brief The identity tour (1, 2, ..., n).
+ * @param n Number of vertices.
+ * @return The identity permutation of [n].
+ */
+std::vector<int> identityTour(const int n);
+
+/**
+ * @brief Builds two edge-disjoint Hamiltonian (s, t)-paths with endpoints 1 and n.
+ * @param n Number of vertices, n >= 6.
+ * @param path1 Output: the identity path, of cost n - 1.
+ * @param path2 Output: a block path, of cost 11(n - 1)/5 + O(1).
+ */
+void constructDisjointPaths(const int n, std::vector<int>& path1, std::vector<int>& path2);
+
+/**
+ * @brief Builds two edge-disjoint Hamiltonian cycles, both odd-depth for n >= 8.
+ * @param n Number of vertices, n >= 6.
+ * @param cycle1 Output: the identity cycle, of cost n.
+ * @param cycle2 Output: a block cycle in canonical form, of cost 11n/5 + O(1).
+ */
+void constructDisjointCycles(const int n, std::vector<int>& cycle1, std::vector<int>& cycle2);
+
+/**
+ * @brief Writes the constructed pair for the given topology as a one-pair witness file.
+ * @param filename Destination file (overwritten).
+ * @param topology "line" or "circle".
+ * @param n Number of vertices, n >= 6.
+ * @param binary If true, use the binary witness format, otherwise the text format.
+ * @return true if the file was written successfully, false otherwise.
+ */
+bool writeConstructedWitness(const std::string& filename, const std::string& topology, const int n, const bool binary);
+
+#endif
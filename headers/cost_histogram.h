@@ -0,0 +1,39 @@
+/**
+ * @file cost_histogram.h
+ * @brief Declarations for counting Hamiltonian paths and cycles by total cost, without enumeration.
+ *
+ * A Held-Karp style dynamic program over (subset, last vertex, cost) counts the tours of every
+ * total cost in O(2^n n^2 C) time, where C is the largest tour cost, instead of listing the n!
+ * tours. The histograms give exact tour counts below any cost bound (to size cost-bucketed
+ * searches) and cross-check the enumerations.
+ */
+
+#ifndef COST_HISTOGRAM_H
+#define COST_HISTOGRAM_H
+
+#include <vector>
+#include <bound.h>
+
+/**
+ * @brief Counts the Hamiltonian (1, n)-paths in the line by total cost.
+ * @param n Number of vertices, 2 <= n <= 21 (memory grows as 2^n n C; n <= 18 is practical).
+ * @return histogram[c] = number of paths of cost c, for c up to the largest path cost.
+ */
+std::vector<unsigned long long> pathCostHistogram(const int n);
+
+/**
+ * @brief Counts the Hamiltonian cycles in the circle by total cost, one per undirected cycle.
+ * @param n Number of vertices, 3 <= n <= 21 (memory grows as 2^n n C; n <= 18 is practical).
+ * @return histogram[c] = number of cycles of cost c, for c up to the largest cycle cost.
+ */
+std::vector<unsigned long long> cycleCostHistogram(const int n);
+
+/**
+ * @brief Number of tours whose cost is strictly below a bound, read from a histogram.
+ * @param histogram Cost histogram (from pathCostHistogram or cycleCostHistogram).
+ * @param bound Cost threshold.
+ * @return The number of tours of cost c with c < bound.
+ */
+unsigned long long countToursWithinBound(const std::vector<unsigned long long>& histogram, const Bound& bound);
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file cycle_symmetry.h
+ * @brief Declarations for enumerating pairs of Hamiltonian cycles in the circle up to symmetry.
+ *
+ * The dihedral group D_n (rotations and reflections of the circle) preserves cycle costs and
+ * edge-disjointness. These functions enumerate one representative per orbit of unordered pairs
+ * {T1, T2} under D_n, which cuts the pair space by a factor of about 4n, and recover exact totals
+ * from the orbit sizes.
+ */
+
+#ifndef CYCLE_SYMMETRY_H
+#define CYCLE_SYMMETRY_H
+
+#include <vector>
+#include <bound.h>
+
+/**
+ * @brief Number of orbits of unordered cycle pairs found, and the number of pairs they contain.
+ */
+struct PairOrbitCount {
+    long long orbits;
+    long long pairs;
+};
+
+/**
+ * @brief Applies a symmetry of the circle to a Hamiltonian cycle.
+ * @param cycle A cycle represented as a permutation of [n].
+ * @param shift Rotation amount, in [0, n).
+ * @param reflect If true, vertex v is mapped to shift - v (mod n) instead of v + shift (mod n).
+ * @return The image cycle, in canonical form.
+ */
+std::vector<int> transformCycle(const std::vector<int>& cycle, const int shift, const bool reflect);
+
+/**
+ * @brief Counts the orbits of unordered pairs of edge-disjoint Hamiltonian cycles of length n.
+ * @param n Number of vertices, n >= 3.
+ * @return The number of orbits and the total number of pairs (as countDisjointCycles).
+ */
+PairOrbitCount countDisjointCyclePairOrbits(const int n);
+
+/**
+ * @brief Counts the orbits of unordered pairs of odd-depth, edge-disjoint Hamiltonian cycles of
+ *        length n whose total cost is below a given bound.
+ * @param n Number of vertices, n >= 3.
+ * @param bound Cost threshold.
+ * @return The number of orbits containing such a pair, and the total number of such pairs
+ *         (as countDisjointCyclesWithinBound).
+ */
+PairOrbitCount countDisjointCyclePairOrbitsWithinBound(const int n, const Bound& bound);
+
+/**
+ * @brief Symmetry-reduced counterpart of findDisjointCycles().
+ * @param n Number of vertices, n >= 3.
+ * @param witness1 Output: first cycle of the pair, if one is found.
+ * @param witness2 Output: second cycle of the pair, if one is found.
+ * @return true if two edge-disjoint Hamiltonian cycles exist, false otherwise.
+ */
+bool findDisjointCyclesUpToSymmetry(const int n, std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Symmetry-reduced counterpart of findDisjointCyclesWithinBound().
+ * @param n Number of vertices, n >= 3.
+ * @param bound Cost threshold.
+ * @param witness1 Output: first cycle of the pair, if one is found.
+ * @param witness2 Output: second cycle of the pair, if one is found.
+ * @return true if two odd-depth, edge-disjoint Hamiltonian cycles with total cost below the
+ *         bound exist, false otherwise.
+ */
+bool findDisjointCyclesWithinBoundUpToSymmetry(const int n, const Bound& bound,
+                                               std::vector<int>& witness1, std::vector<int>& witness2);
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file distance_matrix.h
+ * @brief Declarations for disjoint tour searches under an arbitrary integer metric.
+ *
+ * Beyond uniformly spaced points on a line or a circle, vertex i and j may be at any symmetric
+ * integer distance d(i, j). A DistanceMatrix is read from a file (plain matrix or TSPLIB) or
+ * generated (Euclidean grid, random points), and the searches run on the same PairEngine as the
+ * line and the circle, through the MatrixTopology policy: tour costs are computed once from the
+ * matrix, and the pair loop (adjacency masks, pruning, threading) is unchanged.
+ * Directed variants (arc-disjoint tours, possibly asymmetric costs d(a, b) != d(b, a)) run on the
+ * same engine through DirectedMatrixTopology.
+ */
+
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <vector>
+#include <string>
+#include <bound.h>
+#include <pair_engine.h>
+
+/**
+ * @brief Largest number of vertices of a distance matrix (so that n * n entries fit an int index).
+ */
+const int DISTANCE_MATRIX_MAX_N = 46340;
+
+/**
+ * @brief Integer distances between the vertices 1, ..., n (symmetric, except for directed searches).
+ */
+struct DistanceMatrix {
+    int n;
+    std::vector<int> weights;        // Row-major n x n, weights[(a - 1) * n + (b - 1)] = d(a, b).
+
+    int at(const int a, const int b) const{ return weights[(a - 1) * n + (b - 1)]; }
+};
+
+/**
+ * @brief Topology policy of tours under a distance matrix: (1, n)-paths if Closed is false,
+ *        cycles otherwise. There is no depth filter.
+ */
+template <bool Closed>
+struct MatrixTopology {
+    static constexpr bool closed = Closed;
+    static constexpr bool directed = false;
+    const DistanceMatrix* matrix;
+
+    int edgeCost(const int, const int a, const int b) const{ return matrix->at(a, b); }
+    template <class Visit>
+    void forEachTour(const int n, Visit&& visit) const{
+        if (Closed) forEachCycle(n, visit);
+        else forEachPath(n, visit);
+    }
+    bool passesDepthFilter(const std::vector<int>&) const{ return true; }
+};
+
+/**
+ * @brief Topology policy of directed tours under a (possibly asymmetric) distance matrix:
+ *        directed (1, n)-paths if Closed is false, directed cycles (both orientations) otherwise.
+ *        Tours are compared arc by arc, and an arc a -> b costs d(a, b).
+ */
+template <bool Closed>
+struct DirectedMatrixTopology {
+    static constexpr bool closed = Closed;
+    static constexpr bool directed = true;
+    const DistanceMatrix* matrix;
+
+    int edgeCost(const int, const int a, const int b) const{ return matrix->at(a, b); }
+    template <class Visit>
+    void forEachTour(const int n, Visit&& visit) const{
+        if (Closed) forEachDirectedCycle(n, visit);
+        else forEachPath(n, visit);
+    }
+    bool passesDepthFilter(const std::vector<int>&) const{ return true; }
+};
+
+/**
+ * @brief Checks that a matrix is a valid distance matrix.
+ * @param matrix Candidate matrix.
+ * @param requireSymmetric Whether d(a, b) = d(b, a) is required (false for directed instances).
+ * @return true if it is n x n with 2 <= n <= DISTANCE_MATRIX_MAX_N, with a zero diagonal, weights in
+ *         [0, INT_MAX / (2n)] (so that the cost of a pair of tours fits an int), and symmetric if required.
+ */
+bool isValidDistanceMatrix(const DistanceMatrix& matrix, const bool requireSymmetric = true);
+
+/**
+ * @brief Distances |a - b| of uniformly spaced points on the line.
+ * @param n Number of vertices.
+ * @return The distance matrix.
+ */
+DistanceMatrix lineDistanceMatrix(const int n);
+
+/**
+ * @brief Distances min(|a - b|, n - |a - b|) of uniformly spaced points on the circle.
+ * @param n Number of vertices.
+ * @return The distance matrix.
+ */
+DistanceMatrix circleDistanceMatrix(const int n);
+
+/**
+ * @brief Euclidean distances (rounded to the nearest integer, as TSPLIB EUC_2D) of a grid,
+ *        numbered row by row.
+ * @param rows Number of rows.
+ * @param columns Number of columns.
+ * @param spacing Distance between neighbouring grid points.
+ * @return The distance matrix, with n = rows * columns.
+ */
+DistanceMatrix gridDistanceMatrix(const int rows, const int columns, const int spacing);
+
+/**
+ * @brief Euclidean distances (rounded as TSPLIB EUC_2D) of uniformly random integer points.
+ * @param n Number of vertices.
+ * @param side Points are drawn in [0, side]^2.
+ * @param seed Random seed.
+ * @return The distance matrix.
+ */
+DistanceMatrix randomPointsDistanceMatrix(const int n, const int side, const unsigned seed);
+
+/**
+ * @brief Reads a plain distance matrix: n, followed by the n * n entries row by row.
+ * A header n that the rest of the file is too short to fill is rejected before any allocation.
+ * @param filename Source file.
+ * @param matrix Destination matrix.
+ * @param requireSymmetric Whether an asymmetric matrix is rejected.
+ * @return true if the file was read and holds a valid distance matrix, false otherwise.
+ */
+bool readDistanceMatrix(const std::string& filename, DistanceMatrix& matrix, const bool requireSymmetric = true);
+
+/**
+ * @brief Reads a TSPLIB instance.
+ * Supported: EDGE_WEIGHT_TYPE EUC_2D, CEIL_2D and ATT with a NODE_COORD_SECTION, and EXPLICIT
+ * with EDGE_WEIGHT_FORMAT FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW or LOWER_DIAG_ROW;
+ * any other or missing format is rejected.
+ * Instances of TYPE ATSP may be asymmetric (FULL_MATRIX). As for readDistanceMatrix, a DIMENSION
+ * that the rest of the file is too short to fill is rejected before any allocation.
+ * @param filename Source file.
+ * @param matrix Destination matrix.
+ * @return true if the file was read and holds a valid distance matrix, false otherwise.
+ */
+bool readTsplibInstance(const std::string& filename, DistanceMatrix& matrix);
+
+/**
+ * @brief Finds two edge-disjoint (1, n)-paths (or cycles) with total cost below a bound.
+ * @param matrix Distance matrix, on n <= 12 vertices in practice (exhaustive search).
+ * @param closed Search for cycles instead of paths.
+ * @param bound Strict upper bound on the total cost (Bound(LLONG_MAX) for none).
+ * @param witness1 Receives the first tour of the pair, if found.
+ * @param witness2 Receives the second tour of the pair, if found.
+ * @return true if such a pair exists, false otherwise.
+ */
+bool findDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed, const Bound& bound,
+                               std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Finds two edge-disjoint (1, n)-paths (or cycles) of minimum total cost.
+ * @param matrix Distance matrix, on n <= 12 vertices in practice (exhaustive search).
+ * @param closed Search for cycles instead of paths.
+ * @param witness1 Receives the first tour of an optimal pair, if any.
+ * @param witness2 Receives the second tour of an optimal pair, if any.
+ * @return The minimum total cost, or -1 if there is no disjoint pair.
+ */
+long long minDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed,
+                                   std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Finds two arc-disjoint directed (1, n)-paths (or directed cycles) with total cost below a bound.
+ * @param matrix Distance matrix, possibly asymmetric, on n <= 11 vertices in practice.
+ * @param closed Search for directed cycles instead of paths.
+ * @param bound Strict upper bound on the total cost (Bound(LLONG_MAX) for none).
+ * @param witness1 Receives the first tour of the pair, if found.
+ * @param witness2 Receives the second tour of the pair, if found.
+ * @return true if such a pair exists, false otherwise.
+ */
+bool findArcDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed, const Bound& bound,
+                                  std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Finds two arc-disjoint directed (1, n)-paths (or directed cycles) of minimum total cost.
+ * @param matrix Distance matrix, possibly asymmetric, on n <= 11 vertices in practice.
+ * @param closed Search for directed cycles instead of paths.
+ * @param witness1 Receives the first tour of an optimal pair, if any.
+ * @param witness2 Receives the second tour of an optimal pair, if any.
+ * @return The minimum total cost, or -1 if there is no arc-disjoint pair.
+ */
+long long minArcDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed,
+                                      std::vector<int>& witness1, std::vector<int>& witness2);
+
+#endif
@@ -0,0 +1,32 @@
+/**
+ * @file endpoint_paths.h
+ * @brief Declarations for the minimum cost of two disjoint Hamiltonian paths, for every pair
+ *        of endpoints of the line at once.
+ *
+ * findDisjointPathsBetween (see hamiltonian_paths.h) is the reference for one pair of endpoints;
+ * the table here runs the pair search of PairEngine on every endpoint bucket, one bucket per
+ * thread at a time, and searches only one bucket of each pair that is mirrored by the reflection
+ * of the line.
+ * Note that the buckets are independent searches, each enumerating its own (n - 2)! paths: there
+ * is no single enumeration of all paths shared by the buckets. The table therefore does about half
+ * of the work of n(n - 1)/2 calls to findDisjointPathsBetween (mirror symmetry), not the cost of
+ * one enumeration, in exchange for holding one bucket per thread instead of all n!/2 paths.
+ */
+
+#ifndef ENDPOINT_PATHS_H
+#define ENDPOINT_PATHS_H
+
+#include <vector>
+
+/**
+ * @brief Minimum total cost of two edge-disjoint Hamiltonian (s, t)-paths, for every pair of
+ *        endpoints at once.
+ * @param n Number of vertices, n >= 2.
+ * @param threads Number of threads (0 for the hardware concurrency).
+ * @return A table of size (n + 1) x (n + 1): entry [s][t] (s != t) is the minimum cost for
+ *         endpoints s and t (symmetric in s and t), or -1 if there is no disjoint pair;
+ *         row 0, column 0 and the diagonal are -1.
+ */
+std::vector<std::vector<long long>> minDisjointPathCostsForAllEndpoints(const int n, int threads = 0);
+
+#endif
@@ -3,10 +3,14 @@
  * @brief Declarations for functions on Hamiltonian cycles in the circle with uniformly spaced points.
  * 
  * These functions provide cost calculations, disjointness and depth tests, and existence checks for 
- * Hamiltonian cycles under cost bounds.
+ * Hamiltonian cycles under cost bounds. *
+ * The existence checks and searches are plain double loops over the enumeration, kept as the
+ * reference that the differential test compares against. The production searches (incremental
+ * sweep, result cache, session) run on PairEngine instead (see pair_engine.h).
  */
 
 #include <vector>
+#include <bound.h>
 
 /**
  * @brief Determines whether a Hamiltonian cycle is odd-depth.
@@ -15,6 +19,20 @@
  */
 bool isOddDepthCycle(const std::vector<int>& cycle);
 
+/**
+ * @brief Change of depth parity of a cycle (in canonical form, see isOddDepthCycle) when some
+ *        of its edges are replaced, computed in O(edges) without rebuilding the cycle.
+ * @param n Number of vertices.
+ * @param removed Removed edges, as consecutive label pairs.
+ * @param added Added edges, as consecutive label pairs.
+ * @param edges Number of removed (and of added) edges.
+ * @param neighbour1 A neighbour of 1 before the change.
+ * @param neighbour2 The other neighbour of 1 before the change.
+ * @return 1 if the parity flips, 0 otherwise.
+ */
+int depthParityChange(const int n, const int* removed, const int* added, const int edges,
+                      const int neighbour1, const int neighbour2);
+
 /**
  * @brief Computes the total cost of a Hamiltonian cycle in the circle.
  * @param cycle A cycle represented as a permutation of [n] starting with 1.
@@ -29,7 +47,7 @@ int computeCostCycle(const std::vector<int>& cycle);
  * @param bound Cost threshold.
  * @return true if the sum of the cycle costs is strictly less than the bound, false otherwise.
  */
-bool areCyclesWithinBound(const std::vector<int>& cycle1, const std::vector<int>& cycle2, const double bound);
+bool areCyclesWithinBound(const std::vector<int>& cycle1, const std::vector<int>& cycle2, const Bound& bound);
 
 /**
  * @brief Tests whether a given (undirected) edge is present in a Hamiltonian cycle.
@@ -48,6 +66,54 @@ bool edgeExistsInCycle(int tail, int head, const std::vector<int>& cycle);
  */
 bool areDisjointCycles(const std::vector<int>& cycle1, const std::vector<int>& cycle2);
 
+/**
+ * @brief Rewrites a Hamiltonian cycle in canonical form.
+ * @param cycle A cycle represented as a permutation of [n], in any rotation and orientation.
+ * @return The same (undirected) cycle starting with 1 and with last element larger than the second.
+ */
+std::vector<int> canonicalCycle(const std::vector<int>& cycle);
+
+/**
+ * @brief Enumerates all Hamiltonian cycles of length n, one per undirected cycle.
+ * @param n Number of vertices, n >= 3.
+ * @return The (n - 1)!/2 cycles, as permutations of [n] starting with 1 and with
+ *         last element larger than the second (canonical form).
+ */
+std::vector<std::vector<int>> enumerateCycles(const int n);
+
+/**
+ * @brief Builds all Hamiltonian cycles of length n + 1 by inserting vertex n + 1 into
+ *        every gap of every Hamiltonian cycle of length n.
+ * @param cycles All canonical cycles of length n (e.g. from enumerateCycles).
+ * @return All canonical cycles of length n + 1, each exactly once.
+ */
+std::vector<std::vector<int>> extendCyclesByInsertion(const std::vector<std::vector<int>>& cycles);
+
+/**
+ * @brief Converts a Hamiltonian cycle into successor/predecessor arrays indexed by vertex.
+ * @param cycle A Hamiltonian cycle on [n] (any rotation or orientation).
+ * @param successor Output: successor of each vertex, resized to at least n + 1 (index 0 unused).
+ * @param predecessor Output: predecessor of each vertex, resized to at least n + 1 (index 0 unused).
+ */
+void buildCycleAdjacency(const std::vector<int>& cycle, std::vector<int>& successor, std::vector<int>& predecessor);
+
+/**
+ * @brief Checks in O(n) that no edge of a cycle belongs to the cycle described by adjacency arrays.
+ * @param cycle A Hamiltonian cycle on [n].
+ * @param successor Successor array of the other cycle (from buildCycleAdjacency).
+ * @param predecessor Predecessor array of the other cycle (from buildCycleAdjacency).
+ * @return true if the cycles are disjoint, false otherwise.
+ */
+bool cycleAvoidsAdjacency(const std::vector<int>& cycle, const std::vector<int>& successor, const std::vector<int>& predecessor);
+
+/**
+ * @brief Checks whether two Hamiltonian cycles are edge-disjoint in O(n) time, for large n.
+ * @param cycle1 First Hamiltonian cycle (any rotation or orientation).
+ * @param cycle2 Second Hamiltonian cycle (any rotation or orientation).
+ * @return true if the cycles are disjoint, false otherwise.
+ */
+bool areDisjointCyclesLinear(const std::vector<int>& cycle1, const std::vector<int>& cycle2);
+
 /**
  * @brief Determines if there exist two edge-disjoint Hamiltonian cycles of length n.
  * @param n Number of vertices.
@@ -62,4 +128,57 @@ bool disjointCyclesExist(const int n);
  * @param bound Cost threshold.
  * @return true if such cycles exist, false otherwise.
  */
-bool disjointCyclesExistWithinBound(const int n, const double bound);
+bool disjointCyclesExistWithinBound(const int n, const Bound& bound);
+
+/**
+ * @brief Searches for two edge-disjoint Hamiltonian cycles of length n.
+ * @param n Number of vertices.
+ * @param witness1 Output: first cycle of the pair, if one is found.
+ * @param witness2 Output: second cycle of the pair, if one is found.
+ * @return true if such cycles exist, false otherwise.
+ */
+bool findDisjointCycles(const int n, std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Searches for two odd-depth, edge-disjoint Hamiltonian cycles of length n
+ *        whose total cost is below a given bound.
+ * @param n Number of vertices.
+ * @param bound Cost threshold.
+ * @param witness1 Output: first cycle of the pair, if one is found.
+ * @param witness2 Output: second cycle of the pair, if one is found.
+ * @return true if such cycles exist, false otherwise.
+ */
+bool findDisjointCyclesWithinBound(const int n, const Bound& bound,
+                                   std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Counts the unordered pairs of edge-disjoint Hamiltonian cycles of length n.
+ * @param n Number of vertices.
+ * @return The number of pairs.
+ */
+long long countDisjointCycles(const int n);
+
+/**
+ * @brief Counts the unordered pairs of odd-depth, edge-disjoint Hamiltonian cycles of length n
+ *        whose total cost is below a given bound.
+ * @param n Number of vertices.
+ * @param bound Cost threshold.
+ * @return The number of pairs.
+ */
+long long countDisjointCyclesWithinBound(const int n, const Bound& bound);
+
+/**
+ * @brief Enumerates all directed Hamiltonian cycles of length n (both orientations).
+ * @param n Number of vertices, n >= 3.
+ * @return The (n - 1)! cycles, as permutations of [n] starting with 1, in lexicographic order.
+ */
+std::vector<std::vector<int>> enumerateDirectedCycles(const int n);
+
+/**
+ * @brief Checks whether two directed Hamiltonian cycles are arc-disjoint, i.e. no arc (a, b)
+ *        is followed by both (the arcs (a, b) and (b, a) are distinct).
+ * @param cycle1 First directed cycle, starting with 1.
+ * @param cycle2 Second directed cycle, starting with 1.
+ * @return true if the cycles are arc-disjoint, false otherwise.
+ */
+bool areArcDisjointCycles(const std::vector<int>& cycle1, const std::vector<int>& cycle2);
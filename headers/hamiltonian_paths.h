@@ -3,10 +3,14 @@
  * @brief Declarations for functions on Hamiltonian (s, t)-paths in the line with uniformly spaced points.
  *
  * These functions provide cost calculations, disjointness tests, and existence checks for Hamiltonian 
- * (s, t)-paths under cost bounds.
+ * (s, t)-paths under cost bounds. *
+ * The existence checks and searches are plain double loops over the enumeration, kept as the
+ * reference that the differential test compares against. The production searches (incremental
+ * sweep, result cache, session) run on PairEngine instead (see pair_engine.h).
  */
 
 #include <vector>
+#include <bound.h>
 
 /**
  * @brief Computes the total cost of a Hamiltonian (s, t)-path.
@@ -24,7 +28,7 @@ int computeCostPath(const std::vector<int>& path);
  */
 bool arePathsWithinBound(const std::vector<int>& path1,
                          const std::vector<int>& path2,
-                         const double bound);
+                         const Bound& bound);
 
 /**
  * @brief Tests whether a given (undirected) edge is present in a path.
@@ -44,6 +48,50 @@ bool edgeExistsInPath(int tail, int head, const std::vector<int>& path);
 bool areDisjointPaths(const std::vector<int>& path1,
                       const std::vector<int>& path2);
 
+/**
+ * @brief Converts a Hamiltonian path into successor/predecessor arrays indexed by vertex.
+ * @param path A Hamiltonian path on [n].
+ * @param successor Output: successor of each vertex (0 for the last one), resized to at least n + 1.
+ * @param predecessor Output: predecessor of each vertex (0 for the first one), resized to at least n + 1.
+ */
+void buildPathAdjacency(const std::vector<int>& path, std::vector<int>& successor, std::vector<int>& predecessor);
+
+/**
+ * @brief Checks in O(n) that no edge of a path belongs to the path described by adjacency arrays.
+ * @param path A Hamiltonian path on [n].
+ * @param successor Successor array of the other path (from buildPathAdjacency).
+ * @param predecessor Predecessor array of the other path (from buildPathAdjacency).
+ * @return true if the paths are disjoint, false otherwise.
+ */
+bool pathAvoidsAdjacency(const std::vector<int>& path, const std::vector<int>& successor, const std::vector<int>& predecessor);
+
+/**
+ * @brief Checks whether two Hamiltonian paths are edge-disjoint in O(n) time, for large n.
+ * @param path1 First Hamiltonian path.
+ * @param path2 Second Hamiltonian path.
+ * @return true if the paths are disjoint, false otherwise.
+ */
+bool areDisjointPathsLinear(const std::vector<int>& path1, const std::vector<int>& path2);
+
+/**
+ * @brief Enumerates all Hamiltonian (s, t)-paths of length n with s = 1 and t = n.
+ * @param n Number of vertices, n >= 2.
+ * @return The (n - 2)! paths, as permutations of [n] with endpoints 1 and n.
+ */
+std::vector<std::vector<int>> enumeratePaths(const int n);
+
+/**
+ * @brief Builds all Hamiltonian (s, t)-paths of length n + 1 by inserting vertex n into
+ *        every gap of the interior of every path of length n and appending n + 1.
+ * @param paths All paths of length n with endpoints 1 and n (e.g. from enumeratePaths).
+ * @param costs Costs of the given paths.
+ * @param extendedCosts Output: costs of the returned paths, updated incrementally.
+ * @return All paths of length n + 1 with endpoints 1 and n + 1, each exactly once.
+ */
+std::vector<std::vector<int>> extendPathsByInsertion(const std::vector<std::vector<int>>& paths,
+                                                     const std::vector<int>& costs,
+                                                     std::vector<int>& extendedCosts);
+
 /**
  * @brief Determines if there exist two edge-disjoint Hamiltonian (s, t)-paths of length n.
  * @param n Number of vertices.
@@ -58,4 +106,69 @@ bool disjointPathsExist(const int n);
  * @param bound Cost threshold.
  * @return true if such paths exist, false otherwise.
  */
-bool disjointPathsExistWithinBound(const int n, const double bound);
+bool disjointPathsExistWithinBound(const int n, const Bound& bound);
+
+/**
+ * @brief Searches for two edge-disjoint Hamiltonian (s, t)-paths of length n.
+ * @param n Number of vertices.
+ * @param witness1 Output: first path of the pair, if one is found.
+ * @param witness2 Output: second path of the pair, if one is found.
+ * @return true if such paths exist, false otherwise.
+ */
+bool findDisjointPaths(const int n, std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Searches for two edge-disjoint Hamiltonian (s, t)-paths of length n
+ *        whose total cost is below a given bound.
+ * @param n Number of vertices.
+ * @param bound Cost threshold.
+ * @param witness1 Output: first path of the pair, if one is found.
+ * @param witness2 Output: second path of the pair, if one is found.
+ * @return true if such paths exist, false otherwise.
+ */
+bool findDisjointPathsWithinBound(const int n, const Bound& bound,
+                                  std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Enumerates all Hamiltonian (s, t)-paths of length n for arbitrary endpoints.
+ * @param n Number of vertices.
+ * @param s First endpoint, in [n].
+ * @param t Last endpoint, in [n], t != s.
+ * @return The (n - 2)! paths, starting with s and ending with t, interiors in lexicographic order.
+ */
+std::vector<std::vector<int>> enumeratePathsBetween(const int n, const int s, const int t);
+
+/**
+ * @brief Searches for two edge-disjoint Hamiltonian (s, t)-paths of length n, for arbitrary endpoints.
+ * @param n Number of vertices.
+ * @param s First endpoint.
+ * @param t Last endpoint, t != s.
+ * @param witness1 Output: first path of the pair, if one is found.
+ * @param witness2 Output: second path of the pair, if one is found.
+ * @return true if such paths exist, false otherwise.
+ */
+bool findDisjointPathsBetween(const int n, const int s, const int t,
+                              std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Searches for two edge-disjoint Hamiltonian (s, t)-paths of length n, for arbitrary
+ *        endpoints, whose total cost is below a given bound.
+ * @param n Number of vertices.
+ * @param s First endpoint.
+ * @param t Last endpoint, t != s.
+ * @param bound Cost threshold.
+ * @param witness1 Output: first path of the pair, if one is found.
+ * @param witness2 Output: second path of the pair, if one is found.
+ * @return true if such paths exist, false otherwise.
+ */
+bool findDisjointPathsBetweenWithinBound(const int n, const int s, const int t, const Bound& bound,
+                                         std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Checks whether two directed Hamiltonian paths are arc-disjoint, i.e. no arc (a, b)
+ *        is followed by both (the arcs (a, b) and (b, a) are distinct).
+ * @param path1 First path, read from its first to its last vertex.
+ * @param path2 Second path, read from its first to its last vertex.
+ * @return true if the paths are arc-disjoint, false otherwise.
+ */
+bool areArcDisjointPaths(const std::vector<int>& path1, const std::vector<int>& path2);
@@ -0,0 +1,92 @@
+/**
+ * @file huge_pages.h
+ * @brief Declarations for huge-page backed allocation of the large search tables.
+ *
+ * From n = 11 on, the tour tables of a materialized search reach hundreds of megabytes to
+ * gigabytes, and the pair loop jumps across them: with 4 KiB pages, most of its loads miss the
+ * TLB. Large tables (the oversized blocks of TourArena) are therefore mapped directly, and backed by
+ * huge pages when the system allows it:
+ *   - Explicit: a MAP_HUGETLB mapping from the reserved huge page pool, falling back to
+ *     Transparent if the pool is empty or absent;
+ *   - Transparent: a huge-page aligned anonymous mapping marked with madvise(MADV_HUGEPAGE),
+ *     which the kernel backs with transparent huge pages when it can;
+ *   - Off: plain operator new.
+ * Any failure falls back to the next option, so allocation never fails because of huge pages.
+ * The statistics report how much of the tables was actually backed by huge pages. Transparent
+ * huge pages are measured in /proc/self/smaps, only when the statistics are read: a table
+ * released before any read counts as unmeasured.
+ * Huge pages are opt-in: the pair loop reads the tables row after row, which the TLB handles
+ * well, while faulting in transparent huge pages may stall on memory compaction. Measure with
+ * the statistics before enabling them on a given machine.
+ */
+
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief How large tables are mapped.
+ */
+enum class HugePagePolicy { Off, Transparent, Explicit };
+
+/**
+ * @brief Sets the policy for the tables allocated from now on (Off by default).
+ */
+void setHugePagePolicy(const HugePagePolicy policy);
+
+/**
+ * @brief Current policy.
+ */
+HugePagePolicy hugePagePolicy();
+
+/**
+ * @brief Reads a policy name ("off", "transparent" or "explicit").
+ * @return true if the name is valid, with the policy in policy.
+ */
+bool parseHugePagePolicy(const std::string& name, HugePagePolicy& policy);
+
+/**
+ * @brief Size of a huge page (Hugepagesize in /proc/meminfo, 2 MiB if unknown).
+ */
+std::size_t hugePageSize();
+
+/**
+ * @brief Maps a large table according to the policy.
+ * @param bytes Size of the table; the mapping is rounded up to whole huge pages.
+ * @return The table, to be released with releaseLargeTable, or nullptr if the policy is Off or
+ *         no mapping could be made (the caller then allocates it normally).
+ */
+void* allocateLargeTable(const std::size_t bytes);
+
+/**
+ * @brief Unmaps a table returned by allocateLargeTable.
+ */
+void releaseLargeTable(void* table);
+
+/**
+ * @brief Cumulative statistics over all the large tables requested so far.
+ */
+struct HugePageStats {
+    std::size_t tables;             // Number of tables requested.
+    std::size_t requestedBytes;     // Total size requested.
+    std::size_t explicitBytes;      // Backed by MAP_HUGETLB pages.
+    std::size_t transparentBytes;   // Backed by transparent huge pages (as last measured).
+    std::size_t unmeasuredBytes;    // Transparent mappings released before any measurement.
+    std::size_t regularBytes;       // Allocated normally (policy Off, or no mapping possible).
+};
+
+/**
+ * @brief Current statistics. Live transparent mappings are measured now (one pass over
+ * /proc/self/smaps, without holding up allocations), and a table released later keeps its
+ * last measurement.
+ */
+HugePageStats hugePageStats();
+
+/**
+ * @brief One-line human-readable summary of the statistics.
+ */
+std::string hugePageStatsLine(const HugePageStats& stats);
+
+#endif
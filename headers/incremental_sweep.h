@@ -0,0 +1,60 @@
+/**
+ * @file incremental_sweep.h
+ * @brief Declarations for sweeps over a range of n that reuse the tours of size n to build
+ *        the tours of size n + 1 by vertex insertion.
+ *
+ * Instead of enumerating every n from scratch, each sweep generates the tours of the smallest n
+ * once and then extends them level by level. In bounded sweeps, tour costs never decrease under
+ * insertion, so tours that are too expensive for every remaining n are dropped together with
+ * all of their descendants. Answers are read from and written to the result cache.
+ */
+
+#ifndef INCREMENTAL_SWEEP_H
+#define INCREMENTAL_SWEEP_H
+
+#include <vector>
+#include <string>
+#include <bound.h>
+#include <result_cache.h>
+
+/**
+ * @brief Sweep counterpart of findDisjointPaths() for every n in [nMin, nMax].
+ * @param cacheFile Path of the result cache ("" disables caching).
+ * @param nMin Smallest number of vertices, nMin >= 2.
+ * @param nMax Largest number of vertices.
+ * @return One result per n, in increasing order of n.
+ */
+std::vector<QueryResult> sweepDisjointPaths(const std::string& cacheFile, const int nMin, const int nMax);
+
+/**
+ * @brief Sweep counterpart of findDisjointPathsWithinBound() for every n in [nMin, nMax].
+ * @param cacheFile Path of the result cache ("" disables caching).
+ * @param nMin Smallest number of vertices, nMin >= 2.
+ * @param nMax Largest number of vertices.
+ * @param bounds Cost threshold for each n, in increasing order of n.
+ * @return One result per n, in increasing order of n.
+ */
+std::vector<QueryResult> sweepDisjointPathsWithinBound(const std::string& cacheFile, const int nMin, const int nMax,
+                                                       const std::vector<Bound>& bounds);
+
+/**
+ * @brief Sweep counterpart of findDisjointCycles() for every n in [nMin, nMax].
+ * @param cacheFile Path of the result cache ("" disables caching).
+ * @param nMin Smallest number of vertices, nMin >= 3.
+ * @param nMax Largest number of vertices.
+ * @return One result per n, in increasing order of n.
+ */
+std::vector<QueryResult> sweepDisjointCycles(const std::string& cacheFile, const int nMin, const int nMax);
+
+/**
+ * @brief Sweep counterpart of findDisjointCyclesWithinBound() (odd-depth cycles) for every n in [nMin, nMax].
+ * @param cacheFile Path of the result cache ("" disables caching).
+ * @param nMin Smallest number of vertices, nMin >= 3.
+ * @param nMax Largest number of vertices.
+ * @param bounds Cost threshold for each n, in increasing order of n.
+ * @return One result per n, in increasing order of n.
+ */
+std::vector<QueryResult> sweepDisjointCyclesWithinBound(const std::string& cacheFile, const int nMin, const int nMax,
+                                                        const std::vector<Bound>& bounds);
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file lehmer_codes.h
+ * @brief Declarations for the compact permutation codec based on Lehmer codes.
+ *
+ * A tour on [n] is stored as its rank in the factorial number system, which fits in 64 bits
+ * for n <= 20. These functions provide single and batch encoding/decoding, as well as a small
+ * on-disk store for materialized sets of tours.
+ */
+
+#ifndef LEHMER_CODES_H
+#define LEHMER_CODES_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief Largest n whose permutations can be ranked in 64 bits (20! < 2^64 < 21!).
+ */
+const int LEHMER_MAX_N = 20;
+
+/**
+ * @brief Computes the Lehmer rank of a permutation of [n].
+ * @param tour A permutation of [n] (cycle or path), with n <= LEHMER_MAX_N.
+ * @return The lexicographic rank of the permutation, in [0, n!).
+ */
+uint64_t encodeLehmer(const std::vector<int>& tour);
+
+/**
+ * @brief Recovers a permutation of [n] from its Lehmer rank.
+ * @param rank Lexicographic rank of the permutation, in [0, n!).
+ * @param n Number of vertices, with n <= LEHMER_MAX_N.
+ * @return The permutation of [n] with the given rank.
+ */
+std::vector<int> decodeLehmer(uint64_t rank, const int n);
+
+/**
+ * @brief Computes the Lehmer ranks of a set of permutations of [n].
+ * @param tours Permutations of [n], all of the same size.
+ * @return The ranks, in the same order as the input.
+ */
+std::vector<uint64_t> encodeLehmerBatch(const std::vector<std::vector<int>>& tours);
+
+/**
+ * @brief Recovers a set of permutations of [n] from their Lehmer ranks.
+ * @param ranks Lexicographic ranks, each in [0, n!).
+ * @param n Number of vertices, with n <= LEHMER_MAX_N.
+ * @return The permutations, in the same order as the input.
+ */
+std::vector<std::vector<int>> decodeLehmerBatch(const std::vector<uint64_t>& ranks, const int n);
+
+/**
+ * @brief Writes a set of tours to disk as 8-byte Lehmer ranks.
+ * @param filename Destination file (overwritten).
+ * @param n Number of vertices of every tour.
+ * @param tours Permutations of [n].
+ * @return true if the file was written successfully, false otherwise (also, without touching
+ *         the file, if n is not in [1, LEHMER_MAX_N] or a tour is not a permutation of [n]).
+ */
+bool writeTourStore(const std::string& filename, const int n, const std::vector<std::vector<int>>& tours);
+
+/**
+ * @brief Reads a set of tours written by writeTourStore().
+ * @param filename Source file.
+ * @param n Output: number of vertices of every tour.
+ * @param tours Output: the decoded permutations of [n].
+ * @return true if the file was read successfully, false otherwise.
+ */
+bool readTourStore(const std::string& filename, int& n, std::vector<std::vector<int>>& tours);
+
+#endif
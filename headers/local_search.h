@@ -0,0 +1,69 @@
+/**
+ * @file local_search.h
+ * @brief Declarations for local search heuristics on pairs of edge-disjoint tours.
+ *
+ * The exact searches stop at small n. These heuristics improve a given disjoint pair with
+ * 2-opt and Or-opt moves applied to one tour at a time, never introducing an edge of the
+ * other tour and, for cycles, optionally preserving odd depth. They give quick upper bounds
+ * for n in the tens to hundreds, and seeds for bounded exact searches.
+ */
+
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include <vector>
+
+/**
+ * @brief Outcome of a local search run: total pair cost before and after, and moves applied.
+ */
+struct LocalSearchStats {
+    long long initialCost;
+    long long finalCost;
+    long long moves;
+};
+
+/**
+ * @brief Improves two edge-disjoint paths (endpoints 1 and n) until no improving move is left.
+ * @param path1 First path, improved in place.
+ * @param path2 Second path, improved in place.
+ * @return Costs before and after, and the number of moves applied.
+ */
+LocalSearchStats improveDisjointPaths(std::vector<int>& path1, std::vector<int>& path2);
+
+/**
+ * @brief Improves two edge-disjoint cycles until no improving move is left.
+ * @param cycle1 First cycle, improved in place and returned in canonical form.
+ * @param cycle2 Second cycle, improved in place and returned in canonical form.
+ * @param requireOddDepth If true, both cycles must be odd-depth and stay so.
+ * @return Costs before and after, and the number of moves applied.
+ */
+LocalSearchStats improveDisjointCycles(std::vector<int>& cycle1, std::vector<int>& cycle2, const bool requireOddDepth);
+
+/**
+ * @brief Iterated local search for a low-cost pair of edge-disjoint paths.
+ *        Starts from the block construction and alternates random kicks with local search.
+ * @param n Number of vertices, n >= 6.
+ * @param iterations Number of kick-and-improve rounds.
+ * @param seed Seed of the random number generator.
+ * @param witness1 Output: first path of the best pair found.
+ * @param witness2 Output: second path of the best pair found.
+ * @return Total cost of the best pair found.
+ */
+long long heuristicDisjointPaths(const int n, const int iterations, const unsigned seed,
+                                 std::vector<int>& witness1, std::vector<int>& witness2);
+
+/**
+ * @brief Iterated local search for a low-cost pair of edge-disjoint cycles.
+ *        Starts from the block construction and alternates random kicks with local search.
+ * @param n Number of vertices, n >= 8.
+ * @param iterations Number of kick-and-improve rounds.
+ * @param seed Seed of the random number generator.
+ * @param requireOddDepth If true, only odd-depth pairs are considered.
+ * @param witness1 Output: first cycle of the best pair found.
+ * @param witness2 Output: second cycle of the best pair found.
+ * @return Total cost of the best pair found.
+ */
+long long heuristicDisjointCycles(const int n, const int iterations, const unsigned seed, const bool requireOddDepth,
+                                  std::vector<int>& witness1, std::vector<int>& witness2);
+
+#endif
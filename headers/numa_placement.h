@@ -0,0 +1,114 @@
+/**
+ * @file numa_placement.h
+ * @brief Declarations for placing the parallel pair search on NUMA machines.
+ *
+ * The parallel count of PairEngine reads the whole tour table from every worker. On a machine
+ * with several memory nodes, the table is first-touched by the thread that built the engine, so
+ * the workers of the other nodes read it remotely. These helpers describe the node layout (from
+ * /sys/devices/system/node, without libnuma), spread the workers over the nodes, pin them to
+ * cores, and estimate the share of table reads that cross nodes. PairEngine::count can then give
+ * every node its own replica of the read-only tables, first-touched by a worker of that node.
+ */
+
+#ifndef NUMA_PLACEMENT_H
+#define NUMA_PLACEMENT_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief CPUs of each memory node.
+ */
+struct NumaTopology {
+    std::vector<std::vector<int>> cpus;         // cpus[node] = CPUs of the node, in increasing order.
+
+    int nodes() const{ return cpus.size(); }
+};
+
+/**
+ * @brief Reads the node layout from sysfs. Without NUMA information, there is one node holding
+ * all the CPUs the process may run on.
+ */
+NumaTopology detectNumaTopology();
+
+/**
+ * @brief Parses a Linux CPU list such as "0-3,8,10-11".
+ * @return The CPUs in increasing order (empty if the list is malformed).
+ */
+std::vector<int> parseCpuList(const std::string& list);
+
+/**
+ * @brief Node and CPU of a worker thread.
+ */
+struct WorkerPlacement {
+    int node;
+    int cpu;
+};
+
+/**
+ * @brief Spreads workers over the nodes in proportion to their CPU counts, and over the CPUs of
+ * each node (cycling if there are more workers than CPUs).
+ * @param topology Node layout.
+ * @param threads Number of workers.
+ */
+std::vector<WorkerPlacement> placeWorkers(const NumaTopology& topology, const int threads);
+
+/**
+ * @brief Restricts the calling thread to one CPU.
+ * @return true if the affinity was set.
+ */
+bool pinCurrentThread(const int cpu);
+
+/**
+ * @brief CPU the calling thread is running on (-1 if unknown).
+ */
+int currentCpu();
+
+/**
+ * @brief Node of a CPU (0 if unknown).
+ */
+int numaNodeOfCpu(const NumaTopology& topology, const int cpu);
+
+/**
+ * @brief Node of the CPU the calling thread is running on (0 if unknown).
+ */
+int currentNumaNode(const NumaTopology& topology);
+
+/**
+ * @brief Options of a parallel pair search.
+ */
+struct ParallelOptions {
+    int threads{0};                             // 0 for the hardware concurrency.
+    bool pinThreads{false};                     // Pin each worker to the CPU of its placement.
+    bool replicateTables{false};                // One copy of the tables per node in use (needs pinThreads).
+    const NumaTopology* topology{nullptr};      // nullptr to detect it.
+};
+
+/**
+ * @brief What a parallel pair search did.
+ */
+struct ParallelReport {
+    int threads;
+    int nodes;                                  // Nodes holding at least one worker.
+    int pinnedThreads;                          // Workers whose affinity was set.
+    int replicas;                               // Copies of the tables (0 when reading the engine's own).
+    double remoteAccessRatio;                   // Estimated share of table reads from a remote node,
+                                                // -1 if unknown (some workers not pinned).
+};
+
+/**
+ * @brief Estimated share of remote table reads when the rows of a table are dealt round-robin
+ * to the workers, the reads of row i scanning the rows after it.
+ * @param rows Number of rows.
+ * @param placements Placement of each worker.
+ * @param tableNodes Node of the table read by each worker.
+ */
+double estimateRemoteAccessRatio(const long long rows, const std::vector<WorkerPlacement>& placements,
+                                 const std::vector<int>& tableNodes);
+
+/**
+ * @brief One-line human-readable summary of a report.
+ */
+std::string parallelReportLine(const ParallelReport& report);
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file pair_counting.h
+ * @brief Declarations for counting edge-disjoint pairs of Hamiltonian cycles by inclusion-exclusion.
+ *
+ * Instead of testing every pair of cycles, the number of ordered pairs (T1, T2) of edge-disjoint
+ * Hamiltonian cycles of K_n is written as
+ *     sum over edge sets S of (-1)^|S| * N(S)^2,
+ * where N(S) is the number of Hamiltonian cycles containing S. N(S) vanishes unless S is a set of
+ * vertex-disjoint path fragments (a linear forest) or a Hamiltonian cycle, and for a linear forest
+ * it only depends on its number of edges and of fragments. The sum is then computed from the
+ * number of linear forests of each shape, obtained by a dynamic program over path fragments, in
+ * polynomial time.
+ */
+
+#ifndef PAIR_COUNTING_H
+#define PAIR_COUNTING_H
+
+#include <string>
+
+/**
+ * @brief Exact signed integer wide enough for the intermediate sums (128 bits).
+ */
+__extension__ typedef __int128 ExactCount;
+
+/**
+ * @brief Decimal representation of an exact count.
+ */
+std::string exactCountToString(ExactCount count);
+
+/**
+ * @brief Number of unordered pairs of edge-disjoint Hamiltonian cycles of K_n, by inclusion-exclusion.
+ * Agrees with countDisjointCycles(n), without enumerating cycles.
+ * @param n Number of vertices, n >= 3.
+ * @return The number of pairs, or -1 if an intermediate value overflows 128 bits.
+ */
+ExactCount countDisjointCyclesInclusionExclusion(const int n);
+
+/**
+ * @brief Number of linear forests of K_n with a given number of edges and path fragments.
+ * @param n Number of vertices.
+ * @param edges Number of edges of the forest.
+ * @param fragments Number of components with at least one edge.
+ * @return The number of such linear forests, or -1 on overflow.
+ */
+ExactCount countLinearForests(const int n, const int edges, const int fragments);
+
+#endif
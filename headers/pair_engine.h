@@ -0,0 +1,483 @@
+/**
+ * @file pair_engine.h
+ * @brief Pair search engine shared by Hamiltonian paths in the line and cycles in the circle.
+ *
+ * The two settings only differ by a few rules, which are gathered in a Topology policy:
+ *   - closed: whether the tour has a closing edge (last vertex back to the first);
+ *   - directed: whether tours are compared arc by arc ((a, b) and (b, a) are distinct), in
+ *     which case enumerate lists both orientations and edgeCost(n, a, b) is the cost of a -> b;
+ *   - edgeCost(n, a, b): |a - b| on the line, min(|a - b|, n - |a - b|) on the circle;
+ *   - forEachTour(n, visit): calls visit on every tour in its canonical form (paths with fixed
+ *     endpoints 1 and n, cycles starting with 1 with last > second), in the order of the
+ *     enumerate functions, reusing one buffer instead of building the list of all tours;
+ *   - passesDepthFilter(tour): the odd-depth requirement of the circle (always true on the line).
+ * PairEngine<Topology> is written once against this policy and specialized at compile time, so
+ * every optimization of the pair loop (adjacency masks, cost pruning, threading) serves both
+ * settings without virtual calls in the hot loop. The engine keeps a copy of the policy object,
+ * so a policy may also carry data (see MatrixTopology in distance_matrix.h); the line and circle
+ * policies are empty and use static members.
+ * The parallel count can pin its workers and replicate the tables per NUMA node (see
+ * numa_placement.h).
+ * The engine tables live in an arena owned by the engine, so engines may be destroyed in any
+ * order; the mask buffers of a search live in the arena of the searching thread, within the
+ * search (see tour_arena.h).
+ */
+
+#ifndef PAIR_ENGINE_H
+#define PAIR_ENGINE_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <climits>
+#include <cassert>
+#include <numeric>
+#include <memory>
+#include <tour_arena.h>
+#include <numa_placement.h>
+#include <thread_pool.h>
+#include <hamiltonian_paths.h>
+#include <hamiltonian_cycles.h>
+
+/**
+ * @brief Calls visit on tour after each rearrangement of tour[first, last), in lexicographic
+ * order, starting from the current one (which must be sorted on that range).
+ */
+template <class Visit>
+void forEachArrangement(std::vector<int>& tour, const int first, const int last, Visit&& visit){
+    do{
+        visit(tour);
+    } while (std::next_permutation(tour.begin() + first, tour.begin() + last));
+}
+
+/**
+ * @brief Calls visit on every (1, n)-path, in the order of enumeratePaths.
+ */
+template <class Visit>
+void forEachPath(const int n, Visit&& visit){
+    std::vector<int> path(n);
+    std::iota(path.begin(), path.end(), 1);
+    forEachArrangement(path, 1, n - 1, visit);
+}
+
+/**
+ * @brief Calls visit on every canonical cycle, in the order of enumerateCycles.
+ */
+template <class Visit>
+void forEachCycle(const int n, Visit&& visit){
+    std::vector<int> cycle(n);
+    std::iota(cycle.begin(), cycle.end(), 1);
+    forEachArrangement(cycle, 1, n, [&visit, n](const std::vector<int>& tour){
+        if (tour[n - 1] > tour[1]) visit(tour);
+    });
+}
+
+/**
+ * @brief Calls visit on every directed cycle starting with 1, in the order of enumerateDirectedCycles.
+ */
+template <class Visit>
+void forEachDirectedCycle(const int n, Visit&& visit){
+    std::vector<int> cycle(n);
+    std::iota(cycle.begin(), cycle.end(), 1);
+    forEachArrangement(cycle, 1, n, visit);
+}
+
+/**
+ * @brief Topology policy of Hamiltonian (1, n)-paths in the line.
+ */
+struct LineTopology {
+    static constexpr bool closed = false;
+    static constexpr bool directed = false;
+    static int edgeCost(const int, const int a, const int b){ return std::abs(a - b); }
+    template <class Visit>
+    static void forEachTour(const int n, Visit&& visit){ forEachPath(n, visit); }
+    static bool passesDepthFilter(const std::vector<int>&){ return true; }
+};
+
+/**
+ * @brief Topology policy of Hamiltonian (s, t)-paths in the line, for arbitrary endpoints.
+ */
+struct LineTopologyBetween {
+    static constexpr bool closed = false;
+    static constexpr bool directed = false;
+    int s;
+    int t;
+
+    static int edgeCost(const int, const int a, const int b){ return std::abs(a - b); }
+    template <class Visit>
+    void forEachTour(const int n, Visit&& visit) const{
+        std::vector<int> path{s};
+        for (int v = 1; v <= n; v++){
+            if (v != s && v != t) path.push_back(v);
+        }
+        path.push_back(t);
+        forEachArrangement(path, 1, n - 1, visit);
+    }
+    static bool passesDepthFilter(const std::vector<int>&){ return true; }
+};
+
+/**
+ * @brief Topology policy of Hamiltonian cycles in the circle.
+ */
+struct CircleTopology {
+    static constexpr bool closed = true;
+    static constexpr bool directed = false;
+    static int edgeCost(const int n, const int a, const int b){
+        int diff = std::abs(a - b);
+        return std::min(diff, n - diff);
+    }
+    template <class Visit>
+    static void forEachTour(const int n, Visit&& visit){ forEachCycle(n, visit); }
+    static bool passesDepthFilter(const std::vector<int>& cycle){ return isOddDepthCycle(cycle); }
+};
+
+/**
+ * @brief Topology policy over a given list of tours, in list order, with the rules of Base
+ * (LineTopology or CircleTopology). For searches that build their own tours, such as the levels
+ * of the incremental sweep. The list is only read while the engine is constructed.
+ */
+template <class Base>
+struct ListedTopology : Base {
+    const std::vector<std::vector<int>>* tours;
+
+    ListedTopology(const std::vector<std::vector<int>>* list) : tours(list) {}
+    template <class Visit>
+    void forEachTour(const int, Visit&& visit) const{
+        for (const std::vector<int>& tour : *tours) visit(tour);
+    }
+};
+
+/**
+ * @brief Total cost of a tour of n vertices under a topology policy.
+ */
+template <class Topology>
+long long tourCost(const Topology& topology, const int* tour, const int n){
+    long long cost{0};
+    const int edges = Topology::closed ? n : n - 1;
+    for (int k = 0; k < edges; k++) cost += topology.edgeCost(n, tour[k], tour[k + 1 < n ? k + 1 : 0]);
+    return cost;
+}
+
+/**
+ * @brief Stores the edges of a tour of n vertices as successor/predecessor arrays of size n + 1,
+ * indexed by vertex (0 for none), against which tourAvoidsMask tests another tour in O(n).
+ */
+template <class Topology>
+void buildTourMask(const int* tour, const int n, int* successor, int* predecessor){
+    std::fill(successor, successor + n + 1, 0);
+    std::fill(predecessor, predecessor + n + 1, 0);
+    const int edges = Topology::closed ? n : n - 1;
+    for (int k = 0; k < edges; k++){
+        int next = tour[k + 1 < n ? k + 1 : 0];
+        successor[tour[k]] = next;
+        predecessor[next] = tour[k];
+    }
+}
+
+/**
+ * @brief Tests whether a tour of n vertices shares no edge (no arc, for directed topologies)
+ * with the tour stored by buildTourMask.
+ */
+template <class Topology>
+bool tourAvoidsMask(const int* tour, const int n, const int* successor, const int* predecessor){
+    const int edges = Topology::closed ? n : n - 1;
+    for (int k = 0; k < edges; k++){
+        int a = tour[k], b = tour[k + 1 < n ? k + 1 : 0];
+        if (successor[a] == b || (!Topology::directed && predecessor[a] == b)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief All tours of [n] (optionally filtered by depth and cost), with the pair loops over them.
+ *
+ * Tours are kept in enumeration order in one flat array. A pair (i, j), i < j, is visited in
+ * lexicographic order, so the first pair found is the same as with the plain double loop.
+ * For a fixed i, the edges of tour i are stored once as successor/predecessor arrays, and each
+ * tour j is tested against them in O(n) (successor only, for directed topologies). Pairs whose
+ * total cost exceeds maxCost are skipped, and so are whole rows i that cannot reach it (suffix
+ * minimum of the costs).
+ */
+template <class Topology>
+class PairEngine {
+public:
+    /**
+     * @brief Enumerates the tours of [n].
+     * @param n Number of vertices.
+     * @param useDepthFilter Keep only the tours passing Topology::passesDepthFilter.
+     * @param maxCost Largest admissible total cost of a pair (LLONG_MAX for none).
+     * @param topology Policy object, for policies that carry data.
+     */
+    PairEngine(const int n, const bool useDepthFilter, const long long maxCost, const Topology& topology = Topology())
+        : arena_(64u << 10), n_(n), maxCost_(maxCost), topology_(topology), builtOnCpu_(currentCpu()),
+          tours_(ArenaAllocator<int>(arena_)), costs_(ArenaAllocator<int>(arena_)), suffixMin_(ArenaAllocator<int>(arena_)) {
+        long long kept{0};                                                              // Sized first: no regrowth of large tables.
+        topology_.forEachTour(n, [&](const std::vector<int>& tour){
+            if (!useDepthFilter || topology_.passesDepthFilter(tour)) kept++;
+        });
+        tours_.reserve(kept * n);
+        costs_.reserve(kept);
+        topology_.forEachTour(n, [&](const std::vector<int>& tour){
+            if (useDepthFilter && !topology_.passesDepthFilter(tour)) return;
+            long long cost = tourCost(topology_, tour.data(), n);
+            assert(cost <= INT_MAX / 2);                                                // Pair sums stay within an int.
+            tours_.insert(tours_.end(), tour.begin(), tour.end());
+            costs_.push_back(cost);
+        });
+        const int m = costs_.size();
+        suffixMin_.assign(m + 1, INT_MAX / 2);
+        for (int i = m - 1; i >= 0; i--) suffixMin_[i] = std::min(suffixMin_[i + 1], costs_[i]);
+    }
+
+    PairEngine(const PairEngine&) = delete;
+    PairEngine& operator=(const PairEngine&) = delete;
+
+    int size() const{ return costs_.size(); }
+
+    int cost(const int i) const{ return costs_[i]; }
+
+    std::vector<int> tour(const int i) const{
+        return std::vector<int>(tours_.begin() + (long long) i * n_, tours_.begin() + (long long) (i + 1) * n_);
+    }
+
+    /**
+     * @brief Finds the first disjoint pair within the cost limit, in lexicographic order.
+     * @return true and the pair in witness1 and witness2 if one exists, false otherwise.
+     */
+    bool findFirst(std::vector<int>& witness1, std::vector<int>& witness2) const{
+        return findFirst(maxCost_, witness1, witness2);
+    }
+
+    /**
+     * @brief Same as findFirst, under another cost limit (the tables do not depend on it).
+     */
+    bool findFirst(const long long maxCost, std::vector<int>& witness1, std::vector<int>& witness2) const{
+        ArenaScope scope;
+        ArenaVector<int> successor(n_ + 1), predecessor(n_ + 1);
+        for (int i = 0; i < size(); i++){
+            if (!rowReachable(i, maxCost)) continue;
+            buildMask(tours_.data(), i, successor, predecessor);
+            for (int j = i + 1; j < size(); j++){
+                if (costs_[i] + costs_[j] > maxCost || !avoidsMask(tours_.data(), j, successor, predecessor)) continue;
+                copyTour(i, witness1);
+                copyTour(j, witness2);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Finds a disjoint pair of minimum total cost within the cost limit.
+     * The limit is lowered to (best - 1) each time a pair is found, so the cost and row pruning
+     * of findFirst get tighter as the search goes.
+     * @return The minimum total cost, with a pair attaining it in witness1 and witness2,
+     *         or -1 if there is no disjoint pair within the limit.
+     */
+    long long findMinimum(std::vector<int>& witness1, std::vector<int>& witness2) const{
+        return findMinimum(maxCost_, witness1, witness2);
+    }
+
+    /**
+     * @brief Same as findMinimum, under another cost limit.
+     */
+    long long findMinimum(const long long maxCost, std::vector<int>& witness1, std::vector<int>& witness2) const{
+        ArenaScope scope;
+        ArenaVector<int> successor(n_ + 1), predecessor(n_ + 1);
+        long long limit = maxCost;
+        long long best{-1};
+        for (int i = 0; i < size(); i++){
+            if (costs_[i] + suffixMin_[i + 1] > limit) continue;
+            buildMask(tours_.data(), i, successor, predecessor);
+            for (int j = i + 1; j < size(); j++){
+                if (costs_[i] + costs_[j] > limit || !avoidsMask(tours_.data(), j, successor, predecessor)) continue;
+                best = costs_[i] + costs_[j];
+                limit = best - 1;
+                copyTour(i, witness1);
+                copyTour(j, witness2);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Counts the disjoint pairs within the cost limit.
+     * Rows are dealt round-robin to the threads, each with its own mask buffers.
+     * @param threads Number of threads (0 for the hardware concurrency).
+     */
+    long long count(int threads = 0) const{
+        ParallelOptions options;
+        options.threads = threads;
+        return count(options);
+    }
+
+    /**
+     * @brief Counts the disjoint pairs within the cost limit, with control over thread placement.
+     * Workers are spread over the NUMA nodes (see numa_placement.h) and optionally pinned. With
+     * replicateTables and pinThreads, and workers on several nodes, each node gets its own copy of the tour,
+     * cost and suffix tables, written by a thread pinned to that node so that its pages are
+     * allocated there (first touch), and the workers only read the copy of their node.
+     * Rows are still dealt round-robin, which balances the work since every replica is complete.
+     * Replicas need pinned workers (an unpinned worker may run on any node), and so does the remote
+     * access estimate: it is -1 (unknown) unless every worker was pinned. Without replicas, the
+     * tables are taken to be on the node of the CPU that built the engine (first touch).
+     * @param options Threads, pinning, replication, and node layout.
+     * @param report If not nullptr, receives the placement and the remote access estimate.
+     */
+    long long count(const ParallelOptions& options, ParallelReport* report = nullptr) const{
+        const int threads = (options.threads > 0) ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        const bool placed = options.pinThreads || options.replicateTables || report != nullptr;
+        NumaTopology detected;
+        if (placed && options.topology == nullptr) detected = detectNumaTopology();
+        const NumaTopology& layout = (options.topology != nullptr) ? *options.topology : detected;
+        std::vector<WorkerPlacement> placements = placed ? placeWorkers(layout, threads)
+                                                         : std::vector<WorkerPlacement>(threads, WorkerPlacement{0, -1});
+        std::vector<bool> used(std::max(1, layout.nodes()), false);
+        for (const WorkerPlacement& placement : placements) used[placement.node] = true;
+        const int nodesInUse = std::count(used.begin(), used.end(), true);
+
+        // Tables read by each node: the engine's own, or one replica per node in use.
+        std::vector<Tables> tables(used.size(), Tables{tours_.data(), costs_.data(), suffixMin_.data()});
+        std::vector<std::unique_ptr<TourArena>> replicaArenas(used.size());
+        const bool replicated = options.replicateTables && options.pinThreads && nodesInUse > 1;
+        if (replicated){
+            std::vector<std::thread> builders;
+            for (int node = 0; node < (int) used.size(); node++){
+                if (!used[node]) continue;
+                replicaArenas[node].reset(new TourArena());
+                builders.emplace_back([this, node, &layout, &tables, &replicaArenas](){
+                    pinCurrentThread(layout.cpus[node].front());
+                    tables[node] = copyTables(*replicaArenas[node]);
+                });
+            }
+            for (std::thread& builder : builders) builder.join();
+        }
+
+        std::vector<long long> partial(threads, 0);
+        std::vector<int> pinned(threads, 0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++){
+            workers.emplace_back([this, t, threads, &partial, &pinned, &placements, &tables, &options](){
+                if (options.pinThreads) pinned[t] = pinCurrentThread(placements[t].cpu);
+                partial[t] = countRows(tables[placements[t].node], maxCost_, t, threads);
+            });
+        }
+        for (std::thread& worker : workers) worker.join();
+        long long total{0};
+        for (long long found : partial) total += found;
+
+        if (report != nullptr){
+            std::vector<int> tableNodes(threads, numaNodeOfCpu(layout, builtOnCpu_));
+            if (replicated){
+                for (int t = 0; t < threads; t++) tableNodes[t] = placements[t].node;
+            }
+            report->threads = threads;
+            report->nodes = nodesInUse;
+            report->pinnedThreads = std::count(pinned.begin(), pinned.end(), 1);
+            report->replicas = replicated ? nodesInUse : 0;
+            report->remoteAccessRatio = (report->pinnedThreads == threads) ? estimateRemoteAccessRatio(size(), placements, tableNodes) : -1;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Counts the disjoint pairs within a cost limit on the workers of a pool, without
+     * starting any thread. Rows are dealt round-robin to pool.size() tasks.
+     */
+    long long count(ThreadPool& pool, const long long maxCost) const{
+        const int tasks = pool.size();
+        const Tables tables{tours_.data(), costs_.data(), suffixMin_.data()};
+        std::vector<long long> partial(tasks, 0);
+        pool.run(tasks, [&](const int t){ partial[t] = countRows(tables, maxCost, t, tasks); });
+        long long total{0};
+        for (long long found : partial) total += found;
+        return total;
+    }
+
+    long long count(ThreadPool& pool) const{ return count(pool, maxCost_); }
+
+    /**
+     * @brief Row step of the pair loop, for searches with their own visiting order or stopping
+     * rule (anytime search, orbit enumeration). Tests the tours j = from, ..., to - 1 in order,
+     * with the mask of tour i built once, and calls visit(j) on those such that keep(j) and
+     * tour j is disjoint from tour i, until visit returns false. Costs are not checked.
+     * @param keep Cheap filter on j, applied before the disjointness test.
+     * @return The j for which visit returned false, or to.
+     */
+    template <class Keep, class Visit>
+    int forEachDisjointInRow(const int i, const int from, const int to, Keep&& keep, Visit&& visit) const{
+        ArenaScope scope;
+        ArenaVector<int> successor(n_ + 1), predecessor(n_ + 1);
+        buildMask(tours_.data(), i, successor, predecessor);
+        for (int j = from; j < to; j++){
+            if (keep(j) && avoidsMask(tours_.data(), j, successor, predecessor) && !visit(j)) return j;
+        }
+        return to;
+    }
+
+private:
+    /**
+     * Read-only tables of the pair loop: the engine's own, or a replica.
+     */
+    struct Tables {
+        const int* tours;
+        const int* costs;
+        const int* suffixMin;
+    };
+
+    Tables copyTables(TourArena& arena) const{
+        const int m = size();
+        int* tours = static_cast<int*>(arena.allocate(sizeof(int) * tours_.size(), 64));
+        int* costs = static_cast<int*>(arena.allocate(sizeof(int) * m, 64));
+        int* suffixMin = static_cast<int*>(arena.allocate(sizeof(int) * (m + 1), 64));
+        std::copy(tours_.begin(), tours_.end(), tours);
+        std::copy(costs_.begin(), costs_.end(), costs);
+        std::copy(suffixMin_.begin(), suffixMin_.end(), suffixMin);
+        return Tables{tours, costs, suffixMin};
+    }
+
+    /**
+     * Pairs (i, j) within the limit with i = first, first + stride, ..., read from the given tables.
+     */
+    long long countRows(const Tables& tables, const long long maxCost, const int first, const int stride) const{
+        ArenaScope scope;
+        ArenaVector<int> successor(n_ + 1), predecessor(n_ + 1);
+        long long found{0};
+        for (int i = first; i < size(); i += stride){
+            if (tables.costs[i] + tables.suffixMin[i + 1] > maxCost) continue;
+            buildMask(tables.tours, i, successor, predecessor);
+            for (int j = i + 1; j < size(); j++){
+                if (tables.costs[i] + tables.costs[j] <= maxCost && avoidsMask(tables.tours, j, successor, predecessor)) found++;
+            }
+        }
+        return found;
+    }
+
+    void copyTour(const int i, std::vector<int>& witness) const{
+        witness.assign(tours_.begin() + (long long) i * n_, tours_.begin() + (long long) (i + 1) * n_);
+    }
+
+    bool rowReachable(const int i, const long long maxCost) const{
+        return costs_[i] + suffixMin_[i + 1] <= maxCost;
+    }
+
+    void buildMask(const int* tours, const int i, ArenaVector<int>& successor, ArenaVector<int>& predecessor) const{
+        buildTourMask<Topology>(tours + (long long) i * n_, n_, successor.data(), predecessor.data());
+    }
+
+    bool avoidsMask(const int* tours, const int j, const ArenaVector<int>& successor, const ArenaVector<int>& predecessor) const{
+        return tourAvoidsMask<Topology>(tours + (long long) j * n_, n_, successor.data(), predecessor.data());
+    }
+
+    TourArena arena_;               // Declared first: outlives the tables. Small blocks, so large tables get blocks of their own.
+    const int n_;
+    const long long maxCost_;
+    const Topology topology_;
+    const int builtOnCpu_;          // CPU that first touched the tables, for the remote access estimate.
+    ArenaVector<int> tours_;
+    ArenaVector<int> costs_;
+    ArenaVector<int> suffixMin_;
+};
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file query_server.h
+ * @brief Declarations for the long-running query server of the main binary.
+ *
+ * Running main (or any one-shot search) per query pays process startup and regenerates the tour
+ * tables every time. The server keeps one Session (see session.h) alive, so its tables, answers
+ * and worker pool stay warm across queries and clients. It speaks a line protocol, one request
+ * per line and one answer line per request:
+ *     exists <line|circle> <n>
+ *     within_bound <line|circle> <n> <p[/q]>      (odd-depth cycles on the circle)
+ *     count <line|circle> <n> [<p[/q]>]           (all disjoint pairs, or those within the bound)
+ *     min <line|circle> <n>
+ *     stats
+ *     quit                                        (closes the connection)
+ *     shutdown                                    (stops a socket server)
+ * Answers are "ok" followed by key=value fields, e.g.
+ *     ok exists=1 witness1=1,3,5,2,4 witness2=1,4,2,5,3 seconds=0.0001
+ * or "error <message>". Tours are written as comma-separated vertices ("-" when there is none).
+ * The protocol is served on standard input / output, or on a Unix domain socket where every
+ * client gets its own thread and all of them share the session.
+ */
+
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <session.h>
+
+/**
+ * @brief Largest n accepted by the server (the circle tables of n = 11 take about 80 MB).
+ */
+const int SERVER_MAX_N = 11;
+
+/**
+ * @brief Answers one request line.
+ * @param session Session answering the query.
+ * @param request The request, without its line break.
+ * @return The answer line, without its line break ("" for quit and shutdown).
+ */
+std::string answerRequest(Session& session, const std::string& request);
+
+/**
+ * @brief Serves the requests read from in, one per line, until quit, shutdown or end of input.
+ * @return 0.
+ */
+int serveStream(Session& session, std::istream& in, std::ostream& out);
+
+/**
+ * @brief Serves the clients of a Unix domain socket, each on its own thread, until a client
+ * sends shutdown. A socket file left at path is replaced, and removed on return; the server
+ * refuses to start if anything else is at path.
+ * @param session Session shared by all clients.
+ * @param path Path of the socket.
+ * @return 0, or 1 if the socket could not be set up (or path holds something other than a socket).
+ */
+int serveUnixSocket(Session& session, const std::string& path);
+
+/**
+ * @brief Client side: sends requests to a server on a Unix domain socket and reads the answers.
+ * @param path Path of the socket.
+ * @param requests Request lines.
+ * @param answers Output: one answer line per request (none for quit and shutdown).
+ * @return true if every answer was received.
+ */
+bool sendRequests(const std::string& path, const std::vector<std::string>& requests, std::vector<std::string>& answers);
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file result_cache.h
+ * @brief Declarations for the persistent on-disk cache of search results.
+ *
+ * Exhaustive queries such as disjointCyclesExistWithinBound(8, 16*8/5) never change their answer,
+ * so their result, witness pair and running time are stored in a local cache file keyed by the
+ * query (topology, n, bound, mode, odd-depth flag) and the code version.
+ */
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <vector>
+#include <string>
+#include <bound.h>
+
+/**
+ * @brief Version of the search code. Bump it whenever a change could alter a cached answer.
+ */
+const std::string POD_CODE_VERSION = "2";
+
+/**
+ * @brief Default location of the cache file, relative to the working directory.
+ */
+const std::string DEFAULT_CACHE_FILE = ".pod_cache";
+
+/**
+ * @brief Identifies a query: "line" or "circle", n, mode "exists" or "within_bound",
+ *        the cost bound (ignored for "exists") and whether cycles must be odd-depth.
+ */
+struct QueryKey {
+    std::string topology;
+    int n;
+    std::string mode;
+    Bound bound;
+    bool oddDepth;
+};
+
+/**
+ * @brief Answer to a query: existence, a witness pair (empty if none) and the search time.
+ */
+struct QueryResult {
+    bool exists;
+    std::vector<int> witness1;
+    std::vector<int> witness2;
+    double seconds;
+};
+
+/**
+ * @brief Serializes a query key (including the code version) into the exact string used in the cache.
+ * @param key The query.
+ * @return The key string.
+ */
+std::string queryKeyString(const QueryKey& key);
+
+/**
+ * @brief Looks up a query in the cache file.
+ * @param cacheFile Path of the cache file.
+ * @param key The query.
+ * @param result Output: the cached answer, if found.
+ * @return true if the query was found in the cache, false otherwise.
+ */
+bool lookupCachedResult(const std::string& cacheFile, const QueryKey& key, QueryResult& result);
+
+/**
+ * @brief Appends the answer to a query to the cache file.
+ * @param cacheFile Path of the cache file.
+ * @param key The query.
+ * @param result The answer to store.
+ * @return true if the entry was written successfully, false otherwise.
+ */
+bool storeCachedResult(const std::string& cacheFile, const QueryKey& key, const QueryResult& result);
+
+/**
+ * @brief Answers a query from the cache, or runs the search and caches its answer.
+ * @param cacheFile Path of the cache file.
+ * @param key The query.
+ * @return The answer to the query.
+ */
+QueryResult runCachedQuery(const std::string& cacheFile, const QueryKey& key);
+
+/**
+ * @brief Cached counterpart of disjointPathsExist().
+ */
+bool cachedDisjointPathsExist(const std::string& cacheFile, const int n);
+
+/**
+ * @brief Cached counterpart of disjointPathsExistWithinBound().
+ */
+bool cachedDisjointPathsExistWithinBound(const std::string& cacheFile, const int n, const Bound& bound);
+
+/**
+ * @brief Cached counterpart of disjointCyclesExist().
+ */
+bool cachedDisjointCyclesExist(const std::string& cacheFile, const int n);
+
+/**
+ * @brief Cached counterpart of disjointCyclesExistWithinBound().
+ */
+bool cachedDisjointCyclesExistWithinBound(const std::string& cacheFile, const int n, const Bound& bound);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file session.h
+ * @brief Declarations for a long-lived session answering many queries in-process.
+ *
+ * Each search function (findDisjointPaths, countDisjointCycles, ...) builds its tour tables and,
+ * for counts, starts its threads, then throws both away. A pipeline issuing thousands of queries
+ * pays that setup on every one. A Session keeps it instead:
+ *   - a ThreadPool (see thread_pool.h), started once, runs every count;
+ *   - the tour tables of each (topology, n, odd-depth) are built on first use and reused for any
+ *     cost bound, since bounds only change the limit of the pair loop, not the tables;
+ *   - answers are memoized by query key, and optionally read from and written to the persistent
+ *     cache of result_cache.h.
+ * The session and everything it holds are reached through libpod.a / libpod.so, which gather all
+ * the sources of src/. A Session may be shared by several threads (as in the query server of
+ * query_server.h): searches on the same tables run concurrently, and counts share the pool.
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <result_cache.h>
+
+/**
+ * @brief Options of a session.
+ */
+struct SessionOptions {
+    int threads{0};                             // Workers of the pool (0 for the hardware concurrency).
+    std::string cacheFile{""};                  // Persistent cache file ("" to keep answers in memory only).
+};
+
+/**
+ * @brief What a session did so far.
+ */
+struct SessionStats {
+    long long queries;                          // Calls to query, countPairs and minimumCost.
+    long long cacheHits;                        // Answered from memory or from the cache file.
+    long long tourSetsBuilt;                    // Tour tables built.
+    long long tourSetsReused;                   // Searches run on tables built earlier.
+};
+
+/**
+ * @brief Owns the worker pool, the tour tables and the answers of a series of queries.
+ */
+class Session {
+public:
+    explicit Session(const SessionOptions& options = SessionOptions());
+    ~Session();
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    /**
+     * @brief Answers a query (see QueryKey): "exists" or "within_bound", on "line" or "circle".
+     * Same answer and witness pair as runCachedQuery; seconds is the time of the search, including
+     * building the tables if this query is the first to need them (for a cache hit, the time
+     * stored when the answer was first computed).
+     */
+    QueryResult query(const QueryKey& key);
+
+    /**
+     * @brief Number of disjoint pairs of the query: all of them for "exists", those within the
+     * bound for "within_bound" (odd-depth ones if key.oddDepth). Counted on the pool; counts are
+     * memoized in memory only.
+     */
+    long long countPairs(const QueryKey& key);
+
+    /**
+     * @brief Smallest total cost of a disjoint pair.
+     * @param topology "line" or "circle".
+     * @param n Number of vertices.
+     * @param oddDepth Restrict to odd-depth cycles (circle only).
+     * @param witness1 Output: first tour of a cheapest pair.
+     * @param witness2 Output: second tour of a cheapest pair.
+     * @return The cost, or -1 if there is no disjoint pair.
+     */
+    long long minimumCost(const std::string& topology, const int n, const bool oddDepth,
+                          std::vector<int>& witness1, std::vector<int>& witness2);
+
+    /**
+     * @brief Frees the tour tables (memoized answers are kept).
+     */
+    void releaseTourSets();
+
+    /**
+     * @brief Number of workers of the pool.
+     */
+    int threads() const;
+
+    SessionStats stats() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file thread_pool.h
+ * @brief Declarations for a fixed pool of worker threads, reused across searches.
+ *
+ * PairEngine::count(threads) starts and joins its threads on every call, which is negligible for
+ * one large search but dominates when thousands of small queries are issued in a row. A
+ * ThreadPool starts its workers once; run() hands them a batch of tasks and waits for the batch.
+ * Workers keep their thread-local arena (see tour_arena.h) from one batch to the next.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * @brief Fixed set of worker threads running batches of indexed tasks.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Number of workers (0 for the hardware concurrency).
+     */
+    explicit ThreadPool(const int threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of workers.
+     */
+    int size() const;
+
+    /**
+     * @brief Runs task(0), ..., task(tasks - 1) on the workers and returns when all are done.
+     * Tasks are handed out one at a time, in increasing order. Concurrent calls are serialized.
+     */
+    void run(const int tasks, const std::function<void(int)>& task);
+
+private:
+    void work();
+
+    std::vector<std::thread> workers_;
+    std::mutex runMutex_;                               // Serializes the callers of run.
+    std::mutex mutex_;                                  // Guards the batch state below.
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(int)>* task_;
+    int tasks_;
+    int next_;
+    int pending_;
+    unsigned long long batch_;
+    bool stopping_;
+};
+
+#endif
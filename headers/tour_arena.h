@@ -0,0 +1,150 @@
+/**
+ * @file tour_arena.h
+ * @brief Declarations for the per-thread bump allocator used by the searches.
+ *
+ * The searches build many short-lived arrays: tour tables, adjacency masks, per-bucket tour
+ * lists. A TourArena hands out memory by bumping an offset in large blocks, and gives it all
+ * back at once by rewinding to a mark, so the blocks are reused from one work unit to the next
+ * and malloc is never called on the hot path once the arena has warmed up. Every thread has its
+ * own arena (threadArena), so threads never contend for the allocator.
+ *
+ * Oversized blocks (made for a request that does not fit a regular block, typically one large
+ * tour table) of at least one huge page are mapped through allocateLargeTable (see huge_pages.h),
+ * so the large tour tables are backed by huge pages when the system allows it. Regular blocks
+ * always come from operator new, and do not count as large tables.
+ *
+ * Arena memory is released in LIFO order: an ArenaScope records a mark when it is created and
+ * rewinds to it when it is destroyed. Containers use it through ArenaAllocator, whose deallocate
+ * does nothing; the memory comes back when the enclosing scope ends.
+ */
+
+#ifndef TOUR_ARENA_H
+#define TOUR_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Bump allocator over a list of blocks, rewound by marks.
+ */
+class TourArena {
+public:
+    /**
+     * @brief Position in the arena, to rewind to.
+     */
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    /**
+     * @param blockBytes Size of the regular blocks; larger requests get a block of their own.
+     */
+    explicit TourArena(const std::size_t blockBytes = 4u << 20);
+    TourArena(const TourArena&) = delete;
+    TourArena& operator=(const TourArena&) = delete;
+
+    /**
+     * @brief Returns bytes of uninitialized memory, valid until the arena is rewound below it.
+     * @param bytes Number of bytes.
+     * @param alignment Alignment of the result (a power of two).
+     */
+    void* allocate(const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Current position, to pass to rewind.
+     */
+    Mark mark() const;
+
+    /**
+     * @brief Gives back everything allocated since the mark. Regular blocks are kept for reuse,
+     * blocks allocated for oversized requests are freed. The mark must not be past the current
+     * position, i.e. it must not have been given back already (asserted).
+     */
+    void rewind(const Mark& mark);
+
+    /**
+     * @brief Gives back everything (rewind to the beginning).
+     */
+    void reset();
+
+    /**
+     * @brief Number of bytes handed out and not given back (alignment padding and the unused tails of filled blocks included).
+     */
+    std::size_t bytesInUse() const;
+
+    /**
+     * @brief Number of bytes held by the blocks, in use or not.
+     */
+    std::size_t bytesReserved() const;
+
+private:
+    struct Release {
+        bool mapped;                // From allocateLargeTable (see huge_pages.h), or from new[].
+        void operator()(unsigned char* data) const;
+    };
+    struct Block {
+        std::unique_ptr<unsigned char, Release> data;
+        std::size_t size;
+    };
+
+    const std::size_t blockBytes_;
+    std::vector<Block> blocks_;
+    std::size_t current_;           // Block being filled; blocks after it are free.
+    std::size_t offset_;            // First free byte of the current block.
+};
+
+/**
+ * @brief The arena of the calling thread.
+ */
+TourArena& threadArena();
+
+/**
+ * @brief Rewinds an arena to its position at construction when destroyed.
+ * Scopes on the same arena must end in the reverse order of their creation: ending an outer
+ * scope first frees the memory of the inner one, and ending the inner one afterwards fails the
+ * assertion of rewind. Objects that may be destroyed in any order need arenas of their own.
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(TourArena& arena = threadArena()) : arena_(arena), mark_(arena.mark()) {}
+    ~ArenaScope(){ arena_.rewind(mark_); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    TourArena& arena_;
+    const TourArena::Mark mark_;
+};
+
+/**
+ * @brief Standard allocator drawing from an arena (by default, the one of the constructing thread).
+ * deallocate is a no-op: memory is given back by the enclosing ArenaScope.
+ */
+template <class T>
+struct ArenaAllocator {
+    using value_type = T;
+    TourArena* arena;
+
+    ArenaAllocator(TourArena& source = threadArena()) : arena(&source) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(const std::size_t count){ return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, const std::size_t){}
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b){ return a.arena == b.arena; }
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b){ return a.arena != b.arena; }
+
+/**
+ * @brief Vector whose storage lives in an arena.
+ */
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
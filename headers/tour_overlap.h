@@ -0,0 +1,45 @@
+/**
+ * @file tour_overlap.h
+ * @brief Declarations for the all-pairs edge overlap of a pool of tours.
+ *
+ * Heuristics and constructions produce thousands of large tours, and we want the number of
+ * edges shared by every pair of them. Testing all pairs with areDisjointCycles costs O(n) or
+ * more per pair. Instead, one pass over the pool builds a hash index from each undirected edge
+ * to the tours containing it, and the overlaps are accumulated edge by edge: an edge found in
+ * m tours adds one to each of its m(m - 1)/2 pairs. The work is O(total edges + sum of m^2),
+ * i.e. O(total edges x average multiplicity), which is small for diverse pools.
+ * Tours may have any labels and sizes, and are not validated.
+ */
+
+#ifndef TOUR_OVERLAP_H
+#define TOUR_OVERLAP_H
+
+#include <vector>
+
+/**
+ * @brief Number of edges shared by every pair of tours of a pool.
+ */
+struct OverlapMatrix {
+    int tours;
+    std::vector<int> shared;                    // tours x tours, row-major; the diagonal holds the distinct edges of each tour.
+    long long distinctEdges;                    // Size of the edge index.
+    long long pairUpdates;                      // Increments made, sum over the edges of m(m - 1)/2.
+
+    int at(const int i, const int j) const{ return shared[(long long) i * tours + j]; }
+};
+
+/**
+ * @brief Builds the overlap matrix of a pool through an edge index.
+ * @param tours The pool.
+ * @param closed true for cycles (the last vertex is joined to the first), false for paths.
+ * @return The matrix; an edge repeated within a tour counts once.
+ */
+OverlapMatrix computeOverlapMatrix(const std::vector<std::vector<int>>& tours, const bool closed);
+
+/**
+ * @brief Reference for one pair: number of distinct undirected edges common to two tours,
+ *        by sorting their edge lists.
+ */
+int countSharedEdges(const std::vector<int>& tour1, const std::vector<int>& tour2, const bool closed);
+
+#endif
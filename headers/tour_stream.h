@@ -0,0 +1,98 @@
+/**
+ * @file tour_stream.h
+ * @brief Declarations for streaming tour pairs from files, for verification at large n.
+ *
+ * For n in the thousands and beyond we cannot enumerate, but candidate tour pairs come from
+ * constructions and heuristics. These functions read such pairs from memory-mapped text or
+ * binary files and validate, cost and test disjointness of each pair in O(n) time, for tours
+ * with up to millions of vertices.
+ *
+ * Text format: one tour per line (whitespace-separated labels); lines 2k and 2k + 1 form
+ * the k-th pair. Empty lines and lines starting with '#' are ignored.
+ * Binary format: "PODT" | uint32 n | pairs of n x int32 labels, until the end of the file.
+ * An empty list of pairs is written with n = 0 and no payload.
+ */
+
+#ifndef TOUR_STREAM_H
+#define TOUR_STREAM_H
+
+#include <vector>
+#include <string>
+#include <functional>
+
+/**
+ * @brief Outcome of checking one tour pair.
+ *        Costs and disjointness are only meaningful when the pair is valid.
+ */
+struct PairReport {
+    long long index;
+    int n;
+    bool valid;
+    long long cost1;
+    long long cost2;
+    bool disjoint;
+};
+
+/**
+ * @brief Aggregate over a whole stream. minTotalCost is -1 if there is no valid disjoint pair.
+ */
+struct StreamSummary {
+    long long pairs;
+    long long invalid;
+    long long disjoint;
+    long long minTotalCost;
+};
+
+/**
+ * @brief Callback invoked once per pair, in file order.
+ */
+typedef std::function<void(const PairReport&)> PairCallback;
+
+/**
+ * @brief Streams tour pairs from a text file.
+ * @param filename Source file.
+ * @param topology "line" (paths with endpoints 1 and n) or "circle" (cycles).
+ * @param callback Invoked for every pair (may be empty).
+ * @param summary Output: aggregate over all pairs.
+ * @return true if the file could be read and is well-formed, false otherwise.
+ */
+bool streamTourPairsText(const std::string& filename, const std::string& topology,
+                         const PairCallback& callback, StreamSummary& summary);
+
+/**
+ * @brief Streams tour pairs from a binary file.
+ * @param filename Source file.
+ * @param topology "line" (paths with endpoints 1 and n) or "circle" (cycles).
+ * @param callback Invoked for every pair (may be empty).
+ * @param summary Output: aggregate over all pairs.
+ * @return true if the file could be read and is well-formed, false otherwise.
+ */
+bool streamTourPairsBinary(const std::string& filename, const std::string& topology,
+                           const PairCallback& callback, StreamSummary& summary);
+
+/**
+ * @brief Reads a pool of tours from a text file: one tour per line, as in the pair format,
+ *        but without pairing or validation (see tour_overlap.h).
+ * @param filename Source file.
+ * @param tours Output: the tours, in file order.
+ * @return true if the file could be read and is well-formed, false otherwise.
+ */
+bool readTourPoolText(const std::string& filename, std::vector<std::vector<int>>& tours);
+
+/**
+ * @brief Writes tour pairs in the text format.
+ * @param filename Destination file (overwritten).
+ * @param pairs Tours, two consecutive entries per pair.
+ * @return true if the file was written successfully, false otherwise.
+ */
+bool writeTourPairsText(const std::string& filename, const std::vector<std::vector<int>>& pairs);
+
+/**
+ * @brief Writes tour pairs in the binary format. All tours must have the same size.
+ * @param filename Destination file (overwritten).
+ * @param pairs Tours, two consecutive entries per pair.
+ * @return true if the file was written successfully, false otherwise.
+ */
+bool writeTourPairsBinary(const std::string& filename, const std::vector<std::vector<int>>& pairs);
+
+#endif
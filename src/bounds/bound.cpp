@@ -0,0 +1,59 @@
+/**
+ * @file bound.cpp
+ * @brief Implementation of the exact rational cost bound.
+ *
+ * Each member declared in bound.h is implemented here.
+ */
+
+#include <string>
+#include <numeric>
+#include <cassert>
+#include <bound.h>
+
+/**
+ * Implementation note:
+ * Normalizing to lowest terms with q > 0 makes equal bounds have equal representations,
+ * which is what the result cache relies on. The domain is checked before negating, which
+ * would overflow for LLONG_MIN.
+ */
+Bound::Bound(long long p, long long q){
+    assert(q != 0);
+    assert(-BOUND_MAX <= p && p <= BOUND_MAX && -BOUND_MAX <= q && q <= BOUND_MAX);
+    if (q < 0){
+        p = -p;
+        q = -q;
+    }
+    long long divisor = std::gcd(p, q);
+    numerator = p / divisor;
+    denominator = q / divisor;
+}
+
+/**
+ * Implementation note:
+ * cost * q could overflow for large costs or denominators, so the cost is compared against
+ * the integer threshold instead, which is exact and cannot overflow in the domain of Bound.
+ */
+bool Bound::admits(long long cost) const{
+    return cost <= maxAdmissibleCost();
+}
+
+/**
+ * Implementation note:
+ * cost * q < p  <=>  cost <= floor((p - 1) / q) for integers and q > 0.
+ * The division is floored explicitly since C++ truncates towards zero. As p >= -BOUND_MAX,
+ * p - 1 does not overflow.
+ */
+long long Bound::maxAdmissibleCost() const{
+    long long dividend = numerator - 1;
+    long long quotient = dividend / denominator;
+    if (dividend % denominator != 0 && dividend < 0) quotient--;
+    return quotient;
+}
+
+std::string Bound::toString() const{
+    return std::to_string(numerator) + "/" + std::to_string(denominator);
+}
+
+bool Bound::operator==(const Bound& other) const{
+    return numerator == other.numerator && denominator == other.denominator;
+}
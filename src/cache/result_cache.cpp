@@ -0,0 +1,157 @@
+/**
+ * @file result_cache.cpp
+ * @brief Implementation of the persistent on-disk cache of search results.
+ *
+ * Each function declared in result_cache.h is implemented here.
+ * Comments focus on the key format, the file layout, and query dispatch.
+ */
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include <cassert>
+#include <hamiltonian_paths.h>
+#include <hamiltonian_cycles.h>
+#include <pair_engine.h>
+#include <lehmer_codes.h>
+#include <result_cache.h>
+
+/**
+ * Implementation note:
+ * The bound is written as its reduced fraction p/q, so two bounds share a key if and
+ * only if they are equal as rationals.
+ * The bound is omitted in "exists" mode since it plays no role there.
+ */
+std::string queryKeyString(const QueryKey& key){
+    std::ostringstream out;
+    out << "v" << POD_CODE_VERSION << " " << key.topology << " n=" << key.n << " mode=" << key.mode;
+    if (key.mode == "exists") out << " bound=-";
+    else out << " bound=" << key.bound.toString();
+    out << " odd=" << key.oddDepth;
+    return out.str();
+}
+
+/**
+ * Helper: witnesses are stored as Lehmer ranks, or "-" if there is no witness to store.
+ */
+static std::string witnessToString(const std::vector<int>& witness){
+    if (witness.empty() || (int) witness.size() > LEHMER_MAX_N) return "-";
+    return std::to_string(encodeLehmer(witness));
+}
+
+/**
+ * Helper: reads a witness field, rejecting anything but "-" or the decimal rank of a
+ * permutation of [n] (so a corrupt entry never reaches decodeLehmer).
+ */
+static bool witnessFromString(const std::string& field, const int n, std::vector<int>& witness){
+    witness.clear();
+    if (field == "-") return true;
+    if (field.empty() || field.size() > 20 || n < 1 || n > LEHMER_MAX_N) return false;
+    uint64_t rank{0}, permutations{1};
+    for (char c : field){
+        if (c < '0' || c > '9' || rank > (UINT64_MAX - (c - '0')) / 10) return false;
+        rank = rank * 10 + (c - '0');
+    }
+    for (int k = 2; k <= n; k++) permutations *= k;
+    if (rank >= permutations) return false;
+    witness = decodeLehmer(rank, n);
+    return true;
+}
+
+/**
+ * Helper: reads a whole field as a non-negative number of seconds.
+ */
+static bool secondsFromString(const std::string& field, double& seconds){
+    char* end{nullptr};
+    seconds = std::strtod(field.c_str(), &end);
+    return !field.empty() && end == field.c_str() + field.size() && seconds >= 0;
+}
+
+/**
+ * Implementation note:
+ * The cache file holds one tab-separated entry per line:
+ *     key | exists (0/1) | seconds | witness1 rank | witness2 rank
+ * Entries are only ever appended, so the last well-formed entry for a key wins.
+ */
+bool lookupCachedResult(const std::string& cacheFile, const QueryKey& key, QueryResult& result){
+    std::ifstream in(cacheFile);
+    if (!in) return false;
+
+    const std::string keyString = queryKeyString(key);
+    bool found{false};
+    std::string line;
+    while (std::getline(in, line)){
+        std::vector<std::string> fields;
+        std::istringstream lineStream(line);
+        std::string field;
+        while (std::getline(lineStream, field, '\t')) fields.push_back(field);
+        if (fields.size() != 5 || fields.at(0) != keyString) continue;                  // Skip other queries and malformed lines.
+
+        QueryResult entry;
+        if ((fields.at(1) != "0" && fields.at(1) != "1") || !secondsFromString(fields.at(2), entry.seconds)
+            || !witnessFromString(fields.at(3), key.n, entry.witness1)
+            || !witnessFromString(fields.at(4), key.n, entry.witness2)) continue;       // Corrupt fields: skip the line too.
+        entry.exists = (fields.at(1) == "1");
+        result = entry;
+        found = true;
+    }
+    return found;
+}
+
+bool storeCachedResult(const std::string& cacheFile, const QueryKey& key, const QueryResult& result){
+    std::ofstream out(cacheFile, std::ios::app);
+    if (!out) return false;
+
+    out << queryKeyString(key) << "\t" << result.exists << "\t" << result.seconds << "\t"
+        << witnessToString(result.witness1) << "\t" << witnessToString(result.witness2) << "\n";
+    return static_cast<bool>(out);
+}
+
+/**
+ * Implementation note:
+ * On a cache miss the query is answered by the pair search of PairEngine, whose first pair is
+ * the one of the reference searches (findDisjointPaths and the like, see hamiltonian_paths.h).
+ * The circle search with a bound only considers odd-depth cycles, so that is the only
+ * within_bound combination accepted for cycles. A failure to write the cache is not fatal.
+ */
+QueryResult runCachedQuery(const std::string& cacheFile, const QueryKey& key){
+    QueryResult result;
+    if (lookupCachedResult(cacheFile, key, result)) return result;
+
+    auto start = std::chrono::steady_clock::now();
+    const long long maxCost = (key.mode == "exists") ? LLONG_MAX : key.bound.maxAdmissibleCost();
+    if (key.topology == "line"){
+        assert(key.mode == "exists" || !key.oddDepth);
+        result.exists = PairEngine<LineTopology>(key.n, false, maxCost).findFirst(result.witness1, result.witness2);
+    }
+    else {
+        assert(key.topology == "circle" && (key.mode == "exists" || key.oddDepth));
+        const bool oddDepth = (key.mode == "within_bound");
+        result.exists = PairEngine<CircleTopology>(key.n, oddDepth, maxCost).findFirst(result.witness1, result.witness2);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    storeCachedResult(cacheFile, key, result);
+    return result;
+}
+
+bool cachedDisjointPathsExist(const std::string& cacheFile, const int n){
+    return runCachedQuery(cacheFile, {"line", n, "exists", Bound(0), false}).exists;
+}
+
+bool cachedDisjointPathsExistWithinBound(const std::string& cacheFile, const int n, const Bound& bound){
+    return runCachedQuery(cacheFile, {"line", n, "within_bound", bound, false}).exists;
+}
+
+bool cachedDisjointCyclesExist(const std::string& cacheFile, const int n){
+    return runCachedQuery(cacheFile, {"circle", n, "exists", Bound(0), false}).exists;
+}
+
+bool cachedDisjointCyclesExistWithinBound(const std::string& cacheFile, const int n, const Bound& bound){
+    return runCachedQuery(cacheFile, {"circle", n, "within_bound", bound, true}).exists;
+}
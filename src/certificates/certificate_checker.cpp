@@ -0,0 +1,251 @@
+/**
+ * @file certificate_checker.cpp
+ * @brief Implementation of the independent certificate checker.
+ *
+ * checkInfeasibilityCertificate() from certificate.h is implemented here, on purpose without
+ * using any other source file of the project: costs, depth and edges are recomputed locally.
+ * Comments focus on what is verified at each step.
+ */
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <certificate.h>
+
+/**
+ * Helper: bounds-checked reader over the certificate bytes.
+ */
+class ByteReader {
+public:
+    ByteReader(const std::vector<char>& bytes) : bytes_(bytes), position_(0) {}
+
+    template <typename T>
+    bool read(T& value){
+        if (bytes_.size() - position_ < sizeof(T)) return false;
+        std::memcpy(&value, bytes_.data() + position_, sizeof(T));
+        position_ += sizeof(T);
+        return true;
+    }
+
+    bool readVarint(unsigned long long& value){
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7){
+            uint8_t byte{0};
+            if (!read(byte)) return false;
+            value |= (unsigned long long) (byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    size_t position() const{ return position_; }
+    bool atEnd() const{ return position_ == bytes_.size(); }
+
+private:
+    const std::vector<char>& bytes_;
+    size_t position_;
+};
+
+/**
+ * Helper: replays the enumeration of certificate_writer.cpp, driven by the tree tokens.
+ */
+class CertificateReplay {
+public:
+    CertificateReplay(ByteReader& reader, const size_t treeEnd, const int n, const bool closed, const bool oddDepth,
+                      const long long p, const long long q)
+        : reader_(reader), treeEnd_(treeEnd), n_(n), closed_(closed), oddDepth_(oddDepth), p_(p), q_(q),
+          minTourCost_(closed ? n : n - 1), used_(n + 1, 0), pruned_(0) {}
+
+    bool run(std::string& error){
+        prefix_.assign(1, 1);
+        used_.at(1) = 1;
+        if (!explore(0, error)) return false;
+        if (reader_.position() != treeEnd_){
+            error = "unused enumeration tokens";
+            return false;
+        }
+        return true;
+    }
+
+    const std::vector<int>& tours() const{ return tours_; }
+    const std::vector<int>& costs() const{ return costs_; }
+    long long pruned() const{ return pruned_; }
+
+    int edgeCost(const int a, const int b) const{
+        int diff = std::abs(a - b);
+        return closed_ ? std::min(diff, n_ - diff) : diff;
+    }
+
+private:
+    /**
+     * Parity of the depth of a canonical cycle: the first edge counts if it does not wrap
+     * around (diff <= n - diff), the closing edge if it strictly does not (diff < n - diff),
+     * and every other edge if it wraps around (diff > n - diff).
+     */
+    bool isOddDepth(const std::vector<int>& tour) const{
+        int parity{0};
+        for (int i = 0; i + 1 < n_; i++){
+            int diff = std::abs(tour[i] - tour[i + 1]);
+            bool wraps = diff > n_ - diff;
+            parity ^= (i == 0) ? !wraps : wraps;
+        }
+        int closingDiff = tour[n_ - 1] - 1;
+        parity ^= closingDiff < n_ - closingDiff;
+        return parity;
+    }
+
+    bool explore(const int prefixCost, std::string& error){
+        const int k = prefix_.size();
+        if (k == n_){
+            int cost = prefixCost + (closed_ ? edgeCost(prefix_.back(), prefix_.front()) : 0);
+            if (closed_ && prefix_.at(n_ - 1) < prefix_.at(1)) return true;
+            if ((long long) (cost + minTourCost_) * q_ >= p_) return true;
+            if (oddDepth_ && !isOddDepth(prefix_)) return true;
+            tours_.insert(tours_.end(), prefix_.begin(), prefix_.end());
+            costs_.push_back(cost);
+            return true;
+        }
+
+        for (int v = 2; v <= n_; v++){
+            if (used_.at(v)) continue;
+            if (!closed_ && (v == n_) != (k == n_ - 1)) continue;
+
+            uint8_t token{0};
+            if (reader_.position() >= treeEnd_ || !reader_.read(token) || token > 1){
+                error = "malformed enumeration token";
+                return false;
+            }
+            int childCost = prefixCost + edgeCost(prefix_.back(), v);
+            if (token == 0){
+                // The claimed bound must be a valid lower bound, and exclude the subtree.
+                unsigned long long claimed{0};
+                if (!reader_.readVarint(claimed) || reader_.position() > treeEnd_){
+                    error = "malformed pruning bound";
+                    return false;
+                }
+                long long remainingEdges = closed_ ? n_ - k : n_ - 1 - k;
+                long long valid = childCost + remainingEdges + minTourCost_;
+                if (claimed > (unsigned long long) valid || (long long) claimed * q_ < p_){
+                    error = "invalid pruning bound " + std::to_string(claimed);
+                    return false;
+                }
+                pruned_++;
+                continue;
+            }
+
+            used_.at(v) = 1;
+            prefix_.push_back(v);
+            bool ok = explore(childCost, error);
+            prefix_.pop_back();
+            used_.at(v) = 0;
+            if (!ok) return false;
+        }
+        return true;
+    }
+
+    ByteReader& reader_;
+    const size_t treeEnd_;
+    const int n_;
+    const bool closed_;
+    const bool oddDepth_;
+    const long long p_;
+    const long long q_;
+    const int minTourCost_;
+    std::vector<char> used_;
+    std::vector<int> prefix_;
+    std::vector<int> tours_;
+    std::vector<int> costs_;
+    long long pruned_;
+};
+
+/**
+ * Implementation note:
+ * 1. The header is parsed and sanity-checked.
+ * 2. The enumeration is replayed: every cut subtree must come with a bound that the checker
+ *    can justify on its own and that reaches p/q, and the surviving tours are collected.
+ * 3. For every pair of surviving tours within the bound (same order as the writer), the
+ *    recorded position k must give an edge of tour i that is also an edge of tour j, tested
+ *    in O(1) with the position arrays of the tours.
+ * Any inconsistency, or leftover byte, rejects the certificate.
+ */
+CertificateReport checkInfeasibilityCertificate(const std::string& filename){
+    CertificateReport report{false, "", "", 0, false, 0, 1, 0, 0, 0};
+    std::ifstream in(filename, std::ios::binary);
+    if (!in){
+        report.error = "cannot open file";
+        return report;
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ByteReader reader(bytes);
+
+    char magic[4];
+    uint32_t version{0}, n{0};
+    uint8_t closed{0}, oddDepth{0};
+    int64_t p{0}, q{0};
+    uint64_t treeBytes{0};
+    bool header = reader.read(magic) && std::memcmp(magic, "PODC", 4) == 0 && reader.read(version) && version == 1 &&
+                  reader.read(closed) && reader.read(oddDepth) && reader.read(n) && reader.read(p) && reader.read(q) &&
+                  reader.read(treeBytes);
+    if (!header || closed > 1 || oddDepth > 1 || (oddDepth && !closed) || n < 3 || n > 255 || q <= 0 ||
+        treeBytes > bytes.size() - reader.position()){
+        report.error = "malformed header";
+        return report;
+    }
+    report.topology = closed ? "circle" : "line";
+    report.n = n;
+    report.oddDepth = oddDepth;
+    report.numerator = p;
+    report.denominator = q;
+
+    CertificateReplay replay(reader, reader.position() + treeBytes, n, closed, oddDepth, p, q);
+    if (!replay.run(report.error)) return report;
+    const std::vector<int>& tours = replay.tours();
+    const std::vector<int>& costs = replay.costs();
+    const long long m = costs.size();
+    report.tours = m;
+    report.prunedSubtrees = replay.pruned();
+
+    uint64_t storedTours{0}, storedPairs{0};
+    if (!reader.read(storedTours) || !reader.read(storedPairs) || storedTours != (uint64_t) m ||
+        storedPairs != bytes.size() - reader.position()){
+        report.error = "tour or pair count mismatch";
+        return report;
+    }
+
+    std::vector<int> positions(m * (n + 1));
+    for (long long i = 0; i < m; i++){
+        for (uint32_t k = 0; k < n; k++) positions[i * (n + 1) + tours[i * n + k]] = k;
+    }
+
+    const int edges = closed ? n : n - 1;
+    for (long long i = 0; i < m; i++){
+        for (long long j = i + 1; j < m; j++){
+            if ((long long) (costs[i] + costs[j]) * q >= p) continue;
+            uint8_t k{0};
+            if (!reader.read(k) || k >= edges){
+                report.error = "malformed pair refutation";
+                return report;
+            }
+            int a = tours[i * n + k];
+            int b = tours[i * n + (k + 1) % n];
+            int gap = std::abs(positions[j * (n + 1) + a] - positions[j * (n + 1) + b]);
+            if (gap != 1 && !(closed && gap == (int) n - 1)){
+                report.error = "pair " + std::to_string(i) + ", " + std::to_string(j) + " is not refuted";
+                return report;
+            }
+            report.pairs++;
+        }
+    }
+    if (!reader.atEnd() || report.pairs != (long long) storedPairs){
+        report.error = "unused pair refutations";
+        return report;
+    }
+
+    report.valid = true;
+    return report;
+}
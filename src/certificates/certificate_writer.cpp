@@ -0,0 +1,157 @@
+/**
+ * @file certificate_writer.cpp
+ * @brief Implementation of the certificate-producing search.
+ *
+ * writeInfeasibilityCertificate() from certificate.h is implemented here; the checker lives in
+ * certificate_checker.cpp so that the checker binary does not depend on the search code.
+ * Comments focus on the enumeration order, which the checker must replay exactly.
+ */
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <cassert>
+#include <bound.h>
+#include <hamiltonian_cycles.h>
+#include <certificate.h>
+
+/**
+ * Helper: state of the certificate-producing enumeration.
+ */
+struct CertificateSearch {
+    int n;
+    bool closed;
+    bool requireOddDepth;
+    long long p;
+    long long q;
+    int minTourCost;
+    std::vector<int> prefix;
+    std::vector<char> used;
+    std::vector<uint8_t> tree;
+    std::vector<std::vector<int>> tours;
+    std::vector<int> costs;
+};
+
+static void putVarint(std::vector<uint8_t>& bytes, unsigned long long value){
+    while (value >= 0x80){
+        bytes.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    bytes.push_back(value);
+}
+
+static int edgeCost(const CertificateSearch& search, const int a, const int b){
+    int diff = std::abs(a - b);
+    return search.closed ? std::min(diff, search.n - diff) : diff;
+}
+
+/**
+ * Implementation note:
+ * Tours are built from the prefix (1), appending unused labels in increasing order. On the
+ * line, n can only be appended last; on the circle, complete tours are kept only in canonical
+ * form (last > second). A child is cut when
+ *     (prefix cost + child edge + remaining edges + minimum tour cost) * q >= p,
+ * since each remaining edge costs at least 1 and the partner tour costs at least the minimum.
+ * The same test removes complete tours, which need no token.
+ */
+static void explore(CertificateSearch& search, const int prefixCost){
+    const int n = search.n;
+    const int k = search.prefix.size();
+    if (k == n){
+        const std::vector<int>& tour = search.prefix;
+        int cost = prefixCost + (search.closed ? edgeCost(search, tour.back(), tour.front()) : 0);
+        if (search.closed && tour.at(n - 1) < tour.at(1)) return;
+        if ((long long) (cost + search.minTourCost) * search.q >= search.p) return;
+        if (search.requireOddDepth && !isOddDepthCycle(tour)) return;
+        search.tours.push_back(tour);
+        search.costs.push_back(cost);
+        return;
+    }
+
+    for (int v = 2; v <= n; v++){
+        if (search.used.at(v)) continue;
+        if (!search.closed && (v == n) != (k == n - 1)) continue;
+
+        int childCost = prefixCost + edgeCost(search, search.prefix.back(), v);
+        int remainingEdges = search.closed ? n - k : n - 1 - k;
+        long long bound = (long long) childCost + remainingEdges + search.minTourCost;
+        if (bound * search.q >= search.p){
+            search.tree.push_back(0);
+            putVarint(search.tree, bound);
+            continue;
+        }
+
+        search.tree.push_back(1);
+        search.used.at(v) = 1;
+        search.prefix.push_back(v);
+        explore(search, childCost);
+        search.prefix.pop_back();
+        search.used.at(v) = 0;
+    }
+}
+
+template <typename T>
+static void writeValue(std::ofstream& out, const T value){
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Implementation note:
+ * Pairs (i, j), i < j, of kept tours are visited in enumeration order, and those within the
+ * bound are refuted by the position k in tour i of an edge (t_i[k], t_i[k + 1]) of tour j.
+ * Tour i is turned into a position array once, so that each edge of tour j is tested in O(1).
+ */
+bool writeInfeasibilityCertificate(const std::string& filename, const std::string& topology, const int n,
+                                   const bool requireOddDepth, const Bound& bound){
+    assert(topology == "line" || topology == "circle");
+    assert(n >= 3 && n <= 255);
+    const bool closed = (topology == "circle");
+    assert(closed || !requireOddDepth);
+
+    CertificateSearch search{n, closed, requireOddDepth, bound.numerator, bound.denominator,
+                             closed ? n : n - 1, {1}, std::vector<char>(n + 1, 0), {}, {}, {}};
+    search.used.at(1) = 1;
+    explore(search, 0);
+
+    std::vector<uint8_t> refutations;
+    const int m = search.tours.size();
+    const int edges = closed ? n : n - 1;
+    std::vector<int> position(n + 1);
+    for (int i = 0; i < m; i++){
+        const std::vector<int>& tour1 = search.tours.at(i);
+        for (int k = 0; k < n; k++) position.at(tour1.at(k)) = k;
+
+        for (int j = i + 1; j < m; j++){
+            if ((long long) (search.costs.at(i) + search.costs.at(j)) * search.q >= search.p) continue;
+            const std::vector<int>& tour2 = search.tours.at(j);
+            int shared{-1};
+            for (int e = 0; e < edges && shared < 0; e++){
+                int a = position.at(tour2.at(e));
+                int b = position.at(tour2.at((e + 1) % n));
+                if (std::abs(a - b) == 1) shared = std::min(a, b);
+                else if (closed && std::abs(a - b) == n - 1) shared = n - 1;
+            }
+            if (shared < 0) return false;                                               // A disjoint pair within the bound.
+            refutations.push_back(shared);
+        }
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write("PODC", 4);
+    writeValue<uint32_t>(out, 1);
+    writeValue<uint8_t>(out, closed);
+    writeValue<uint8_t>(out, requireOddDepth);
+    writeValue<uint32_t>(out, n);
+    writeValue<int64_t>(out, search.p);
+    writeValue<int64_t>(out, search.q);
+    writeValue<uint64_t>(out, search.tree.size());
+    out.write(reinterpret_cast<const char*>(search.tree.data()), search.tree.size());
+    writeValue<uint64_t>(out, m);
+    writeValue<uint64_t>(out, refutations.size());
+    out.write(reinterpret_cast<const char*>(refutations.data()), refutations.size());
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file constructions.cpp
+ * @brief Implementation of the explicit disjoint tour pair constructions.
+ *
+ * Each function declared in constructions.h is implemented here.
+ * Comments focus on the block gadgets and why the pairs are disjoint (and odd-depth).
+ */
+
+#include <vector>
+#include <string>
+#include <numeric>
+#include <cassert>
+#include <hamiltonian_cycles.h>
+#include <tour_stream.h>
+#include <constructions.h>
+
+/**
+ * Block gadgets: a block of length L is a walk from offset 0 to offset L that visits every
+ * offset in [0, L] once and only uses steps of length 2 or 3 (and one of length 5 for L = 7),
+ * so it shares no edge with the identity. Costs on the line are 11, 14, 17, 20 and 21.
+ * These gadgets are the ones found in the exact optima for n <= 11.
+ */
+static const std::vector<std::vector<int>> BLOCKS{
+    {0, 2, 4, 1, 3, 5},                                         // L = 5, cost 11
+    {0, 2, 5, 3, 1, 4, 6},                                      // L = 6, cost 14
+    {0, 2, 4, 6, 1, 3, 5, 7},                                   // L = 7, cost 17
+    {0, 2, 5, 7, 4, 1, 3, 6, 8},                                // L = 8, cost 20
+    {0, 2, 4, 1, 3, 6, 8, 5, 7, 9}                              // L = 9, cost 21
+};
+
+/**
+ * Helper: walks offsets 0, ..., length (length >= 5) with one block of length 5 + (length mod 5)
+ * followed by blocks of length 5, and returns the visited offsets (length + 1 of them).
+ */
+static std::vector<int> blockWalk(const int length){
+    assert(length >= 5);
+    std::vector<int> lengths;
+    int remainder = length % 5;
+    int fives = length / 5;
+    if (remainder != 0){
+        lengths.push_back(5 + remainder);
+        fives--;
+    }
+    lengths.insert(lengths.end(), fives, 5);
+
+    std::vector<int> offsets{0};
+    offsets.reserve(length + 1);
+    int base{0};
+    for (int blockLength : lengths){
+        const std::vector<int>& block = BLOCKS.at(blockLength - 5);
+        for (int k = 1; k < (int) block.size(); k++) offsets.push_back(base + block.at(k));
+        base += blockLength;
+    }
+    return offsets;
+}
+
+std::vector<int> identityTour(const int n){
+    std::vector<int> tour(n);
+    std::iota(tour.begin(), tour.end(), 1);
+    return tour;
+}
+
+/**
+ * Implementation note:
+ * The block path walks from 1 (offset 0) to n (offset n - 1). Every step has length at least 2,
+ * so it is disjoint from the identity path. Each block of 5 costs 11, so the total cost is
+ * (n - 1) + 11(n - 1)/5 + O(1) = 16(n - 1)/5 + O(1); it is exactly 16(n - 1)/5 when 5 divides n - 1.
+ */
+void constructDisjointPaths(const int n, std::vector<int>& path1, std::vector<int>& path2){
+    assert(n >= 6);
+    path1 = identityTour(n);
+    path2 = blockWalk(n - 1);
+    for (int& vertex : path2) vertex += 1;
+}
+
+/**
+ * Implementation note:
+ * The block cycle walks once around the circle, from offset 0 back to offset n = 0 (label 1).
+ * Steps of length 2 or 3 (and 5 < n - 5 for n >= 11, where the length-7 block appears) are
+ * never unit steps of the circle, so the cycle is disjoint from the identity; the total cost
+ * is 16n/5 + O(1), and exactly 16n/5 when 5 divides n.
+ * Depth: the segment (1, 2) is only covered by the edge (1, 3) of the first block, as every
+ * other edge is short and local, so the block cycle has depth 1 (odd), like the identity.
+ * This locality fails for n = 7, where the length-7 block wraps around and the cycle is even.
+ */
+void constructDisjointCycles(const int n, std::vector<int>& cycle1, std::vector<int>& cycle2){
+    assert(n >= 6);
+    cycle1 = identityTour(n);
+    std::vector<int> offsets = blockWalk(n);
+    offsets.pop_back();                                                                 // Offset n closes the cycle at label 1.
+    for (int& vertex : offsets) vertex += 1;
+    cycle2 = canonicalCycle(offsets);
+}
+
+bool writeConstructedWitness(const std::string& filename, const std::string& topology, const int n, const bool binary){
+    assert(topology == "line" || topology == "circle");
+    std::vector<std::vector<int>> pair(2);
+    if (topology == "line") constructDisjointPaths(n, pair.at(0), pair.at(1));
+    else constructDisjointCycles(n, pair.at(0), pair.at(1));
+
+    return binary ? writeTourPairsBinary(filename, pair) : writeTourPairsText(filename, pair);
+}
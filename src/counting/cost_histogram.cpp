@@ -0,0 +1,109 @@
+/**
+ * @file cost_histogram.cpp
+ * @brief Implementation of the Held-Karp counting of tours by cost.
+ *
+ * Each function declared in cost_histogram.h is implemented here.
+ * Comments focus on the state space and on keeping only two layers of it in memory.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cassert>
+#include <bound.h>
+#include <pair_engine.h>
+#include <cost_histogram.h>
+
+/**
+ * Helper: Held-Karp counting over the free vertices, for the line or circle policy.
+ *
+ * A tour starts at 1, visits the free vertices (2, ..., n - 1 for paths, 2, ..., n for cycles)
+ * in some order, and ends with the terminal (n for paths, back to 1 for cycles).
+ * dp[mask][i][c] counts the walks from 1 through exactly the free vertices of mask, ending at
+ * free vertex i, with cost c. Masks are processed by increasing size, and a mask is released
+ * once it has been extended, so only two consecutive layers are ever allocated. For each mask,
+ * [low, high] bounds the costs that can be non-zero, which keeps the inner loop short.
+ */
+template <class Topology>
+static std::vector<unsigned long long> heldKarpHistogram(const int n){
+    const int terminal = Topology::closed ? 1 : n;
+    std::vector<int> freeVertices;
+    for (int v = 2; v <= (Topology::closed ? n : n - 1); v++) freeVertices.push_back(v);
+    const int f = freeVertices.size();
+    assert(f <= 20);
+
+    int maxEdge{0};
+    for (int a = 1; a <= n; a++){
+        for (int b = a + 1; b <= n; b++) maxEdge = std::max(maxEdge, Topology::edgeCost(n, a, b));
+    }
+    const int maxCost = (Topology::closed ? n : n - 1) * maxEdge;
+    const int width = maxCost + 1;
+    std::vector<unsigned long long> histogram(width, 0);
+    if (f == 0){
+        histogram.at(Topology::edgeCost(n, 1, terminal))++;
+        histogram.resize(Topology::edgeCost(n, 1, terminal) + 1);
+        return histogram;
+    }
+
+    const unsigned full = (1u << f) - 1;
+    std::vector<std::vector<unsigned long long>> dp(full + 1);
+    std::vector<int> low(full + 1, INT_MAX), high(full + 1, -1);
+    for (int g = 0; g < f; g++){
+        int cost = Topology::edgeCost(n, 1, freeVertices[g]);
+        dp[1u << g].assign((long long) f * width, 0);
+        dp[1u << g][(long long) g * width + cost] = 1;
+        low[1u << g] = high[1u << g] = cost;
+    }
+
+    for (int size = 1; size <= f; size++){
+        for (unsigned mask = (1u << size) - 1; mask <= full; ){
+            std::vector<unsigned long long>& counts = dp[mask];
+            for (int i = 0; i < f && !counts.empty(); i++){
+                if (!(mask >> i & 1)) continue;
+                const unsigned long long* row = counts.data() + (long long) i * width;
+                if (size == f){
+                    int closing = Topology::edgeCost(n, freeVertices[i], terminal);
+                    for (int c = low[mask]; c <= high[mask]; c++) histogram[c + closing] += row[c];
+                    continue;
+                }
+                for (int g = 0; g < f; g++){
+                    if (mask >> g & 1) continue;
+                    const unsigned next = mask | (1u << g);
+                    const int step = Topology::edgeCost(n, freeVertices[i], freeVertices[g]);
+                    if (dp[next].empty()) dp[next].assign((long long) f * width, 0);
+                    unsigned long long* target = dp[next].data() + (long long) g * width + step;
+                    for (int c = low[mask]; c <= high[mask]; c++) target[c] += row[c];
+                    low[next] = std::min(low[next], low[mask] + step);
+                    high[next] = std::max(high[next], high[mask] + step);
+                }
+            }
+            std::vector<unsigned long long>().swap(counts);                             // Release the mask.
+
+            unsigned lowest = mask & -mask, ripple = mask + lowest;                     // Next mask of the same size.
+            mask = (((ripple ^ mask) >> 2) / lowest) | ripple;
+        }
+    }
+
+    if (Topology::closed){
+        for (unsigned long long& count : histogram) count /= 2;                        // Both orientations were counted.
+    }
+    while (histogram.size() > 1 && histogram.back() == 0) histogram.pop_back();
+    return histogram;
+}
+
+std::vector<unsigned long long> pathCostHistogram(const int n){
+    assert(n >= 2 && n <= 21);
+    return heldKarpHistogram<LineTopology>(n);
+}
+
+std::vector<unsigned long long> cycleCostHistogram(const int n){
+    assert(n >= 3 && n <= 21);
+    return heldKarpHistogram<CircleTopology>(n);
+}
+
+unsigned long long countToursWithinBound(const std::vector<unsigned long long>& histogram, const Bound& bound){
+    unsigned long long count{0};
+    const long long maxCost = bound.maxAdmissibleCost();
+    for (long long c = 0; c < (long long) histogram.size() && c <= maxCost; c++) count += histogram[c];
+    return count;
+}
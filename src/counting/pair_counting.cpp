@@ -0,0 +1,126 @@
+/**
+ * @file pair_counting.cpp
+ * @brief Implementation of the inclusion-exclusion count of edge-disjoint cycle pairs.
+ *
+ * Each function declared in pair_counting.h is implemented here.
+ * Comments focus on the combinatorial identities used, and on overflow handling: every
+ * operation is checked, and -1 is propagated as soon as 128 bits are not enough.
+ */
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <pair_counting.h>
+
+/**
+ * Helper: checked arithmetic on exact counts, where -1 marks an overflow.
+ */
+static ExactCount checkedAdd(const ExactCount a, const ExactCount b){
+    ExactCount sum;
+    if (a < 0 || b < 0 || __builtin_add_overflow(a, b, &sum)) return -1;
+    return sum;
+}
+
+static ExactCount checkedMultiply(const ExactCount a, const ExactCount b){
+    ExactCount product;
+    if (a < 0 || b < 0 || __builtin_mul_overflow(a, b, &product)) return -1;
+    return product;
+}
+
+std::string exactCountToString(ExactCount count){
+    if (count == 0) return "0";
+    bool negative = count < 0;
+    std::string digits;
+    while (count != 0){
+        int digit = (int) (count % 10);
+        digits.push_back('0' + (negative ? -digit : digit));
+        count /= 10;
+    }
+    if (negative) digits.push_back('-');
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+/**
+ * Helper: binomial coefficients C(a, b) for a <= size, by Pascal's rule.
+ */
+static std::vector<std::vector<ExactCount>> binomials(const int size){
+    std::vector<std::vector<ExactCount>> table(size + 1, std::vector<ExactCount>(size + 1, 0));
+    for (int a = 0; a <= size; a++){
+        table[a][0] = 1;
+        for (int b = 1; b <= a; b++) table[a][b] = checkedAdd(table[a - 1][b - 1], table[a - 1][b]);
+    }
+    return table;
+}
+
+/**
+ * Implementation note:
+ * ways[m][p] counts the ways to split m labelled vertices into p unordered undirected paths
+ * of at least two vertices. The path through the largest vertex has k >= 2 vertices: its other
+ * k - 1 vertices are chosen among m - 1, and they can be ordered in k!/2 ways, so
+ *     ways[m][p] = sum over k of C(m - 1, k - 1) * k!/2 * ways[m - k][p - 1].
+ * A linear forest with e edges and p fragments covers m = e + p vertices, chosen in C(n, m) ways.
+ */
+ExactCount countLinearForests(const int n, const int edges, const int fragments){
+    const int m = edges + fragments;
+    if (fragments < 0 || edges < fragments || m > n) return 0;
+    if (fragments == 0) return edges == 0 ? 1 : 0;
+    std::vector<std::vector<ExactCount>> choose = binomials(n);
+
+    std::vector<ExactCount> halfFactorial(m + 1, 0);                                   // k!/2 for k >= 2.
+    halfFactorial[2] = 1;
+    for (int k = 3; k <= m; k++) halfFactorial[k] = checkedMultiply(halfFactorial[k - 1], k);
+
+    std::vector<std::vector<ExactCount>> ways(m + 1, std::vector<ExactCount>(fragments + 1, 0));
+    ways[0][0] = 1;
+    for (int used = 2; used <= m; used++){
+        for (int p = 1; p <= std::min(fragments, used / 2); p++){
+            ExactCount total{0};
+            for (int k = 2; k <= used; k++){
+                if (ways[used - k][p - 1] == 0) continue;
+                ExactCount term = checkedMultiply(checkedMultiply(choose[used - 1][k - 1], halfFactorial[k]), ways[used - k][p - 1]);
+                total = checkedAdd(total, term);
+            }
+            ways[used][p] = total;
+        }
+    }
+    return checkedMultiply(choose[n][m], ways[m][fragments]);
+}
+
+/**
+ * Implementation note:
+ * A linear forest S with e edges and p fragments leaves c = n - e components (fragments and
+ * isolated vertices). The Hamiltonian cycles containing S are the cyclic orders of the c
+ * components, (c - 1)!/2 of them up to reversal, times 2^p orientations of the fragments:
+ *     N(S) = (c - 1)! * 2^(p - 1) if p >= 1, and (n - 1)!/2 if S is empty.
+ * (For c = 1, S is a Hamiltonian path and N(S) = 1.) If S is a Hamiltonian cycle, N(S) = 1,
+ * which adds (-1)^n * (n - 1)!/2 to the sum. All other edge sets have N(S) = 0.
+ * Positive and negative terms are summed separately, and the ordered pairs are halved.
+ */
+ExactCount countDisjointCyclesInclusionExclusion(const int n){
+    assert(n >= 3);
+    std::vector<ExactCount> factorial(n + 1, 1);
+    for (int k = 1; k <= n; k++) factorial[k] = checkedMultiply(factorial[k - 1], k);
+    if (factorial[n - 1] < 0) return -1;
+
+    ExactCount positive{0}, negative{0};
+    const ExactCount hamiltonianCycles = factorial[n - 1] / 2;
+    (n % 2 == 0 ? positive : negative) = hamiltonianCycles;
+
+    for (int edges = 0; edges <= n - 1; edges++){
+        for (int fragments = (edges > 0 ? 1 : 0); fragments <= std::min(edges, n - edges); fragments++){
+            ExactCount forests = countLinearForests(n, edges, fragments);
+            if (forests == 0) continue;
+            const int components = n - edges;
+            ExactCount cycles = (fragments == 0) ? hamiltonianCycles
+                                                 : checkedMultiply(factorial[components - 1], (ExactCount) 1 << (fragments - 1));
+            ExactCount term = checkedMultiply(forests, checkedMultiply(cycles, cycles));
+            ExactCount& sum = (edges % 2 == 0) ? positive : negative;
+            sum = checkedAdd(sum, term);
+            if (term < 0 || sum < 0) return -1;
+        }
+    }
+    if (positive < 0 || negative < 0) return -1;
+    return (positive - negative) / 2;
+}
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <numeric>
 #include <cassert>
+#include <bound.h>
 #include <hamiltonian_cycles.h>
 
 
@@ -49,6 +50,42 @@ bool isOddDepthCycle(const std::vector<int>& cycle){
     return depth % 2;       // Evaluates to true if depth is odd. 
 }
 
+/**
+ * Implementation note:
+ * In isOddDepthCycle, an edge that avoids 1 counts when it cycles back (diff > n - diff).
+ * The two edges at 1 depend on the orientation: in canonical form, 1 is followed by its
+ * smaller neighbour s and preceded by its larger neighbour l, and they count when
+ * s - 1 <= n - (s - 1) and l - 1 < n - (l - 1) respectively (these differ only when
+ * diff = n/2). So the parity change is the sum of the terms of the replaced edges that avoid 1,
+ * plus the change of the combined term of the edges at 1, if the neighbours of 1 change.
+ */
+static int edgesAtOneTerm(const int n, const int neighbour1, const int neighbour2){
+    int second = std::min(neighbour1, neighbour2) - 1;
+    int last = std::max(neighbour1, neighbour2) - 1;
+    return (second <= n - second) + (last < n - last);
+}
+
+int depthParityChange(const int n, const int* removed, const int* added, const int edges,
+                      const int neighbour1, const int neighbour2){
+    int parity{0};
+    int neighbours[2]{neighbour1, neighbour2};
+    bool atOne{false};
+    for (int e = 0; e < 2 * edges; e++){
+        const int* edge = (e < edges) ? removed + 2 * e : added + 2 * (e - edges);
+        if (edge[0] == 1 || edge[1] == 1){
+            int other = (edge[0] == 1) ? edge[1] : edge[0];
+            if (e < edges) *std::find(neighbours, neighbours + 2, other) = 0;           // Removals come first.
+            else *std::find(neighbours, neighbours + 2, 0) = other;
+            atOne = true;
+            continue;
+        }
+        int diff = std::abs(edge[0] - edge[1]);
+        parity += diff > n - diff;
+    }
+    if (atOne) parity += edgesAtOneTerm(n, neighbour1, neighbour2) + edgesAtOneTerm(n, neighbours[0], neighbours[1]);
+    return parity % 2;
+}
+
 /**
  * Implementation note:
  * The cost of an edge (i, j) is defined as:
@@ -79,10 +116,10 @@ int computeCostCycle(const std::vector<int>& cycle){
  * This function simply adds the costs of two cycles (computed via computeCostCycle)
  * and compares against the given threshold.
  */
-bool areCyclesWithinBound(const std::vector<int>& cycle1, const std::vector<int>& cycle2, const double bound){
+bool areCyclesWithinBound(const std::vector<int>& cycle1, const std::vector<int>& cycle2, const Bound& bound){
     int costCycle1 = computeCostCycle(cycle1);
     int costCycle2 = computeCostCycle(cycle2);
-    return (costCycle1 + costCycle2 < bound);
+    return bound.admits(costCycle1 + costCycle2);
 }
 
 /**
@@ -123,14 +160,74 @@ bool areDisjointCycles(const std::vector<int>& cycle1, const std::vector<int>& c
     return true;
 }
 
+/**
+ * Implementation note:
+ * successor[v] and predecessor[v] are the neighbours of v when walking the cycle in the
+ * given orientation (index 0 is unused). The arrays are resized only if too small, so the
+ * same buffers can be reused across many cycles.
+ */
+void buildCycleAdjacency(const std::vector<int>& cycle, std::vector<int>& successor, std::vector<int>& predecessor){
+    int n = cycle.size();
+    if ((int) successor.size() < n + 1) successor.resize(n + 1);
+    if ((int) predecessor.size() < n + 1) predecessor.resize(n + 1);
+
+    for (int i = 0; i < n; i++){
+        int next = cycle.at(i + 1 < n ? i + 1 : 0);
+        successor.at(cycle.at(i)) = next;
+        predecessor.at(next) = cycle.at(i);
+    }
+}
+
+/**
+ * Implementation note:
+ * An edge (a, b) belongs to the cycle described by the arrays if and only if b is the
+ * successor or the predecessor of a, which is an O(1) test. Checking all n edges of the
+ * other cycle (including its closing edge) is then O(n).
+ */
+bool cycleAvoidsAdjacency(const std::vector<int>& cycle, const std::vector<int>& successor, const std::vector<int>& predecessor){
+    int n = cycle.size();
+    for (int i = 0; i < n; i++){
+        int tail = cycle.at(i);
+        int head = cycle.at(i + 1 < n ? i + 1 : 0);
+        if (successor.at(tail) == head || predecessor.at(tail) == head) return false;
+    }
+    return true;
+}
+
+/**
+ * Implementation note:
+ * Linear-time counterpart of areDisjointCycles: cycle1 is converted to adjacency arrays
+ * once, instead of scanning it for every edge of cycle2. Unlike areDisjointCycles, the
+ * cycles need not be in canonical form.
+ */
+bool areDisjointCyclesLinear(const std::vector<int>& cycle1, const std::vector<int>& cycle2){
+    assert(cycle1.size() == cycle2.size());
+    std::vector<int> successor, predecessor;
+    buildCycleAdjacency(cycle1, successor, predecessor);
+    return cycleAvoidsAdjacency(cycle2, successor, predecessor);
+}
+
+/**
+ * Implementation note:
+ * A cycle has 2n sequence representations (n rotations, 2 orientations). The canonical one
+ * starts with 1 and has its last element larger than its second, matching enumerateCycles.
+ */
+std::vector<int> canonicalCycle(const std::vector<int>& cycle){
+    int n = cycle.size();
+    std::vector<int> canonical(cycle);
+    std::rotate(canonical.begin(), std::find(canonical.begin(), canonical.end(), 1), canonical.end());
+    if (n > 2 && canonical.at(n - 1) < canonical.at(1)) std::reverse(canonical.begin() + 1, canonical.end());
+    return canonical;
+}
+
 /**
  * Implementation note:
  * Enumerates all unique Hamiltonian cycles of size n, represented as
  * permutations of [n] beginning with 1 (canonical form).
  * Uses std::next_permutation to generate candidates, skipping symmetric reversals.
- * Tests all pairs for disjointness.
  */
-bool disjointCyclesExist(const int n){
+std::vector<std::vector<int>> enumerateCycles(const int n){
+    assert(n >= 3);
     // Create and populate the identity permutation (1, 2, ..., n)
     std::vector<int> identity(n);
     std::iota(identity.begin(), identity.end(), 1);
@@ -146,14 +243,57 @@ bool disjointCyclesExist(const int n){
         if(identity.at(n - 1) > identity.at(1)) allCycles.push_back(identity);     // Only insert unique cyclic permutations. 
     } while (std::next_permutation(identity.begin(), identity.end()) && identity.at(0) == 1);
 
+    return allCycles;
+}
+
+/**
+ * Implementation note:
+ * Every Hamiltonian cycle of [n + 1] is obtained exactly once by inserting vertex n + 1
+ * into one of the n gaps (edges) of exactly one cycle of [n]: removing n + 1 recovers
+ * both the parent cycle and the gap. Inserting into a canonical cycle keeps 1 in front,
+ * but may break the orientation convention (last > second), in which case the child
+ * is reversed.
+ */
+std::vector<std::vector<int>> extendCyclesByInsertion(const std::vector<std::vector<int>>& cycles){
+    std::vector<std::vector<int>> extended;
+    if (cycles.empty()) return extended;
+
+    int n = cycles.at(0).size();
+    extended.reserve(cycles.size() * n);
+    std::vector<int> child(n + 1);
+    for (const std::vector<int>& cycle : cycles){
+        assert(cycle.at(0) == 1);
+        for (int gap = 1; gap <= n; gap++){                                             // Insert n + 1 right before position gap.
+            std::copy(cycle.begin(), cycle.begin() + gap, child.begin());
+            child.at(gap) = n + 1;
+            std::copy(cycle.begin() + gap, cycle.end(), child.begin() + gap + 1);
+            if (child.at(n) < child.at(1)) std::reverse(child.begin() + 1, child.end());  // Restore the orientation convention.
+            extended.push_back(child);
+        }
+    }
+    return extended;
+}
+
+/**
+ * Implementation note:
+ * Enumerates all unique Hamiltonian cycles of size n (see enumerateCycles).
+ * Tests all pairs for disjointness, and reports the first disjoint pair found.
+ */
+bool findDisjointCycles(const int n, std::vector<int>& witness1, std::vector<int>& witness2){
+    std::vector<std::vector<int>> allCycles = enumerateCycles(n);
+
     // Test every pair of cycles for disjointness
     int m = allCycles.size();
     for (int i = 0; i < m; i++){
         for (int j = i + 1; j < m; j++){
-            std::vector<int> cycle1 = allCycles.at(i);
-            std::vector<int> cycle2 = allCycles.at(j);
+            const std::vector<int>& cycle1 = allCycles.at(i);
+            const std::vector<int>& cycle2 = allCycles.at(j);
 
-            if (areDisjointCycles(cycle1, cycle2)) return true;
+            if (areDisjointCycles(cycle1, cycle2)){
+                witness1 = cycle1;
+                witness2 = cycle2;
+                return true;
+            }
         }
     }
 
@@ -162,39 +302,129 @@ bool disjointCyclesExist(const int n){
 
 /**
  * Implementation note:
- * Same as disjointCyclesExist, but requires both cycles to be odd-depth
+ * Same as findDisjointCycles, but requires both cycles to be odd-depth
  * and the total cost to be below the given threshold.
+ * The cost and depth of every cycle are computed once up front, and the bound is turned
+ * into an integer threshold, so the pair loop only does integer comparisons before
+ * falling back to the (expensive) disjointness test.
  */
-bool disjointCyclesExistWithinBound(const int n, const double bound){
-    // Create and populate the identity permutation (1, 2, ..., n)
-    std::vector<int> identity(n);
-    std::iota(identity.begin(), identity.end(), 1);
+bool findDisjointCyclesWithinBound(const int n, const Bound& bound, std::vector<int>& witness1, std::vector<int>& witness2){
+    std::vector<std::vector<int>> allCycles = enumerateCycles(n);
 
-    // Create and populate a list of all (unique) cyclic permutations of [n] of the form (1, ...).
-    // This is all that is needed since any other permutation can be rewritten with 1 as its first element.    
-    std::vector<std::vector<int>> allCycles;
-    do{
-        // Since "next_permutation" generates permutations in lexicographical order, 
-        // if the last element of the current permutation is smaller than its second element, 
-        // then the reverse permutation has already been generated and the current one can be 
-        // skipped over. 
-        if(identity.at(n - 1) > identity.at(1)) allCycles.push_back(identity);     // Only insert unique cyclic permutations. 
-    } while (std::next_permutation(identity.begin(), identity.end()) && identity.at(0) == 1);
+    // Precompute cycle costs and depths, and the largest admissible total cost
+    int m = allCycles.size();
+    std::vector<int> costs(m);
+    std::vector<bool> oddDepth(m);
+    for (int i = 0; i < m; i++){
+        costs.at(i) = computeCostCycle(allCycles.at(i));
+        oddDepth.at(i) = isOddDepthCycle(allCycles.at(i));
+    }
+    const long long maxCost = bound.maxAdmissibleCost();
 
     // Test every pair of cycles for disjointness
-    int m = allCycles.size();
     for (int i = 0; i < m; i++){
+        if (!oddDepth.at(i)) continue;
         for (int j = i + 1; j < m; j++){
-            std::vector<int> cycle1 = allCycles.at(i);
-            std::vector<int> cycle2 = allCycles.at(j);
-
-            if ((isOddDepthCycle(cycle1) && isOddDepthCycle(cycle2))
-                && areDisjointCycles(cycle1, cycle2) 
-                && areCyclesWithinBound(cycle1, cycle2, bound)){
-                    return true;
-                }
+            if (!oddDepth.at(j) || costs.at(i) + costs.at(j) > maxCost) continue;
+
+            const std::vector<int>& cycle1 = allCycles.at(i);
+            const std::vector<int>& cycle2 = allCycles.at(j);
+
+            if (areDisjointCycles(cycle1, cycle2)){
+                witness1 = cycle1;
+                witness2 = cycle2;
+                return true;
+            }
         }
     }
 
     return false;
 }
+
+/**
+ * Implementation note:
+ * Reference counter: same enumeration and pair loop as findDisjointCycles,
+ * but every pair is tested instead of stopping at the first disjoint one.
+ */
+long long countDisjointCycles(const int n){
+    std::vector<std::vector<int>> allCycles = enumerateCycles(n);
+
+    long long count{0};
+    int m = allCycles.size();
+    for (int i = 0; i < m; i++){
+        for (int j = i + 1; j < m; j++){
+            if (areDisjointCycles(allCycles.at(i), allCycles.at(j))) count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Implementation note:
+ * Same as countDisjointCycles, restricted to odd-depth pairs within the bound
+ * (the pairs findDisjointCyclesWithinBound looks for).
+ */
+long long countDisjointCyclesWithinBound(const int n, const Bound& bound){
+    std::vector<std::vector<int>> allCycles = enumerateCycles(n);
+
+    long long count{0};
+    int m = allCycles.size();
+    for (int i = 0; i < m; i++){
+        const std::vector<int>& cycle1 = allCycles.at(i);
+        if (!isOddDepthCycle(cycle1)) continue;
+        for (int j = i + 1; j < m; j++){
+            const std::vector<int>& cycle2 = allCycles.at(j);
+            if (isOddDepthCycle(cycle2) && areCyclesWithinBound(cycle1, cycle2, bound) && areDisjointCycles(cycle1, cycle2)) count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Implementation note:
+ * Thin wrappers over the witness-reporting searches that discard the witness.
+ */
+bool disjointCyclesExist(const int n){
+    std::vector<int> witness1, witness2;
+    return findDisjointCycles(n, witness1, witness2);
+}
+
+bool disjointCyclesExistWithinBound(const int n, const Bound& bound){
+    std::vector<int> witness1, witness2;
+    return findDisjointCyclesWithinBound(n, bound, witness1, witness2);
+}
+
+/**
+ * Implementation note:
+ * Same as enumerateCycles, without skipping the reversed orientation.
+ */
+std::vector<std::vector<int>> enumerateDirectedCycles(const int n){
+    assert(n >= 3);
+    std::vector<int> identity(n);
+    std::iota(identity.begin(), identity.end(), 1);
+
+    std::vector<std::vector<int>> allCycles;
+    do{
+        allCycles.push_back(identity);
+    } while (std::next_permutation(identity.begin() + 1, identity.end()));
+
+    return allCycles;
+}
+
+/**
+ * Implementation note:
+ * Every arc of cycle1 (including the closing arc back to 1) is looked up among the arcs of
+ * cycle2, in the same direction only.
+ */
+bool areArcDisjointCycles(const std::vector<int>& cycle1, const std::vector<int>& cycle2){
+    assert(cycle1.size() == cycle2.size());
+    int n = cycle1.size();
+    for (int i = 0; i < n; i++){
+        int tail = cycle1.at(i), head = cycle1.at((i + 1) % n);
+        for (int k = 0; k < n; k++){
+            if (cycle2.at(k) == tail && cycle2.at((k + 1) % n) == head) return false;
+        }
+    }
+    return true;
+}
+
@@ -0,0 +1,157 @@
+/**
+ * @file lehmer_codes.cpp
+ * @brief Implementation of the Lehmer code permutation codec and the on-disk tour store.
+ *
+ * Each function declared in lehmer_codes.h is implemented here.
+ * Comments focus on algorithmic details and the file layout.
+ */
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <cassert>
+#include <lehmer_codes.h>
+
+/**
+ * Implementation note:
+ * The Lehmer digit of position i is the number of unused values smaller than tour[i].
+ * Used values are kept in a bitmask, so each digit is a single popcount and the whole
+ * encoding is O(n). Digits are accumulated with Horner's rule in the factorial base:
+ *     rank = (...((d_0 * (n - 1) + d_1) * (n - 2) + d_2)...) * 1 + d_{n-1}.
+ */
+uint64_t encodeLehmer(const std::vector<int>& tour){
+    int n = tour.size();
+    assert(n <= LEHMER_MAX_N);
+
+    uint32_t used{0};
+    uint64_t rank{0};
+    for(int i = 0; i < n; i++){
+        int value = tour.at(i);
+        assert(value >= 1 && value <= n);
+
+        uint32_t below = (1u << (value - 1)) - 1;                                       // Values 1, ..., value - 1.
+        int digit = (value - 1) - __builtin_popcount(used & below);
+        rank = rank * (n - i) + digit;
+        used |= 1u << (value - 1);
+    }
+    return rank;
+}
+
+/**
+ * Implementation note:
+ * Digits are extracted from the least significant end (mixed radix 1, 2, ..., n),
+ * then each digit d selects the (d + 1)-th smallest value not used so far.
+ */
+std::vector<int> decodeLehmer(uint64_t rank, const int n){
+    assert(n <= LEHMER_MAX_N);
+
+    std::vector<int> digits(n);
+    for(int i = n - 1; i >= 0; i--){
+        digits.at(i) = rank % (n - i);
+        rank /= (n - i);
+    }
+    assert(rank == 0);                                          // The rank was in [0, n!).
+
+    std::vector<int> tour(n);
+    uint32_t available = (1u << n) - 1;
+    for(int i = 0; i < n; i++){
+        uint32_t remaining = available;
+        for(int skip = digits.at(i); skip > 0; skip--) remaining &= remaining - 1;     // Drop the lowest set bits.
+        int bit = __builtin_ctz(remaining);
+        tour.at(i) = bit + 1;
+        available &= ~(1u << bit);
+    }
+    return tour;
+}
+
+/**
+ * Implementation note:
+ * Batch versions simply map the single-tour codec over the input, reserving the output once.
+ */
+std::vector<uint64_t> encodeLehmerBatch(const std::vector<std::vector<int>>& tours){
+    std::vector<uint64_t> ranks;
+    ranks.reserve(tours.size());
+    for(const std::vector<int>& tour : tours) ranks.push_back(encodeLehmer(tour));
+    return ranks;
+}
+
+std::vector<std::vector<int>> decodeLehmerBatch(const std::vector<uint64_t>& ranks, const int n){
+    std::vector<std::vector<int>> tours;
+    tours.reserve(ranks.size());
+    for(uint64_t rank : ranks) tours.push_back(decodeLehmer(rank, n));
+    return tours;
+}
+
+/**
+ * Implementation note:
+ * File layout (native endianness):
+ *     "PODL" | uint32 n | uint64 count | count x uint64 rank
+ */
+/**
+ * Implementation note:
+ * The tours are checked before the file is opened, so that a bad call leaves an existing store
+ * intact; a permutation of [n] has n entries in [1, n] covering n distinct bits.
+ */
+bool writeTourStore(const std::string& filename, const int n, const std::vector<std::vector<int>>& tours){
+    if(n < 1 || n > LEHMER_MAX_N) return false;
+    for(const std::vector<int>& tour : tours){
+        if((int) tour.size() != n) return false;
+        uint32_t used{0};
+        for(int value : tour){
+            if(value < 1 || value > n) return false;
+            used |= 1u << (value - 1);
+        }
+        if(used != (1u << n) - 1) return false;
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if(!out) return false;
+
+    std::vector<uint64_t> ranks = encodeLehmerBatch(tours);
+    uint32_t size = n;
+    uint64_t count = ranks.size();
+
+    out.write("PODL", 4);
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(ranks.data()), count * sizeof(uint64_t));
+
+    return static_cast<bool>(out);
+}
+
+/**
+ * Implementation note:
+ * The header is not trusted: count must match the size of the file exactly (checked by division,
+ * so a huge count cannot overflow), and every rank must be below n!, before anything is decoded.
+ */
+bool readTourStore(const std::string& filename, int& n, std::vector<std::vector<int>>& tours){
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if(!in) return false;
+    const std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+
+    char magic[4];
+    uint32_t size{0};
+    uint64_t count{0};
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if(!in || std::memcmp(magic, "PODL", 4) != 0 || size > LEHMER_MAX_N) return false;
+    const uint64_t payload = fileSize - (std::streamoff) (4 + sizeof(size) + sizeof(count));
+    if(payload % sizeof(uint64_t) != 0 || payload / sizeof(uint64_t) != count) return false;
+
+    std::vector<uint64_t> ranks(count);
+    in.read(reinterpret_cast<char*>(ranks.data()), count * sizeof(uint64_t));
+    if(!in) return false;
+    uint64_t permutations{1};
+    for(uint32_t k = 2; k <= size; k++) permutations *= k;
+    for(uint64_t rank : ranks){
+        if(rank >= permutations) return false;
+    }
+
+    n = size;
+    tours = decodeLehmerBatch(ranks, n);
+    return true;
+}
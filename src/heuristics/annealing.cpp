@@ -0,0 +1,295 @@
+/**
+ * @file annealing.cpp
+ * @brief Implementation of the parallel tempering optimizer over disjoint tour pairs.
+ *
+ * Each function declared in annealing.h is implemented here.
+ * Comments focus on the linked tour representation that makes every move O(1).
+ */
+
+#include <vector>
+#include <random>
+#include <thread>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <cassert>
+#include <hamiltonian_cycles.h>
+#include <constructions.h>
+#include <annealing.h>
+
+/**
+ * Helper: one annealing replica, holding a disjoint pair as doubly linked lists.
+ *
+ * next[w][v] and prev[w][v] are the neighbours of v in tour w (0 past the ends of a path).
+ * They serve both as the tour and as the edge mask of the other tour: an edge (a, b) is in
+ * tour w iff next[w][a] == b or prev[w][a] == b. Moves relink at most six vertices:
+ *   - Or-opt: a segment f..l of 1 to 3 vertices, with p -> f and l -> q, is moved, possibly
+ *     reversed, between x -> y.
+ *   - Swap: two vertices u and v exchange their positions.
+ * On paths, vertices 1 and n never move, so they stay the endpoints. Feasibility (no edge of
+ * the other tour, depth parity) and the cost delta only look at the removed and added edges.
+ */
+class Replica {
+public:
+    Replica(const int n, const bool closed, const bool requireOddDepth,
+            const std::vector<int>& tour1, const std::vector<int>& tour2, const unsigned seed)
+        : n_(n), closed_(closed), requireOddDepth_(requireOddDepth), rng_(seed) {
+        const std::vector<int>* tours[2]{&tour1, &tour2};
+        for (int w = 0; w < 2; w++){
+            next_[w].assign(n + 1, 0);
+            prev_[w].assign(n + 1, 0);
+            const std::vector<int>& t = *tours[w];
+            for (int i = 0; i < n; i++){
+                next_[w][t[i]] = (i + 1 < n) ? t[i + 1] : (closed ? t[0] : 0);
+                prev_[w][t[i]] = (i > 0) ? t[i - 1] : (closed ? t[n - 1] : 0);
+            }
+        }
+        cost_ = tourCost(0) + tourCost(1);
+        bestCost_ = cost_;
+        bestNext_[0] = next_[0];
+        bestNext_[1] = next_[1];
+        bestMark_ = NO_MARK;
+    }
+
+    long long cost() const{ return cost_; }
+    long long bestCost() const{ return bestCost_; }
+
+    /**
+     * Metropolis dynamics at a fixed temperature.
+     */
+    void run(const long long moves, const double temperature){
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (long long move = 0; move < moves; move++){
+            int which = rng_() % 2;
+            long long delta{0};
+            bool applied = (rng_() % 2 == 0) ? tryOrOpt(which, temperature, uniform, delta)
+                                             : trySwap(which, temperature, uniform, delta);
+            if (!applied) continue;
+            cost_ += delta;
+            if (cost_ < bestCost_) noteBest();
+        }
+        flushJournal();
+    }
+
+    void bestTours(std::vector<int>& tour1, std::vector<int>& tour2) const{
+        std::vector<int>* tours[2]{&tour1, &tour2};
+        for (int w = 0; w < 2; w++){
+            std::vector<int>& t = *tours[w];
+            t.resize(n_);
+            int v{1};
+            for (int i = 0; i < n_; i++){
+                t[i] = v;
+                v = bestNext_[w][v];
+            }
+            if (closed_) t = canonicalCycle(t);
+        }
+    }
+
+private:
+    int edgeCost(const int a, const int b) const{
+        int diff = std::abs(a - b);
+        return closed_ ? std::min(diff, n_ - diff) : diff;
+    }
+
+    long long tourCost(const int w) const{
+        long long total{0};
+        for (int v = 1; v <= n_; v++){
+            if (next_[w][v] != 0) total += edgeCost(v, next_[w][v]);
+        }
+        return total;
+    }
+
+    bool isEdge(const int w, const int a, const int b) const{
+        return next_[w][a] == b || prev_[w][a] == b;
+    }
+
+    bool isFixed(const int v) const{ return !closed_ && (v == 1 || v == n_); }
+
+    /**
+     * Checks the added edges against the other tour and the depth parity, computes the cost
+     * delta, and applies the Metropolis criterion.
+     */
+    bool accept(const int which, const int* removed, const int* added, const int edges, const double temperature,
+                std::uniform_real_distribution<double>& uniform, long long& delta){
+        delta = 0;
+        for (int e = 0; e < edges; e++){
+            if (isEdge(1 - which, added[2 * e], added[2 * e + 1])) return false;
+            delta += edgeCost(added[2 * e], added[2 * e + 1]) - edgeCost(removed[2 * e], removed[2 * e + 1]);
+        }
+        if (requireOddDepth_ && depthParityChange(n_, removed, added, edges, next_[which][1], prev_[which][1]) != 0) return false;
+        return delta <= 0 || uniform(rng_) < std::exp(-delta / temperature);
+    }
+
+    void link(const int w, const int a, const int b){
+        journal_.push_back(Relink{w, a, next_[w][a]});
+        next_[w][a] = b;
+        prev_[w][b] = a;
+        if (journal_.size() > 8 * (std::size_t) (n_ + 1)) flushJournal();
+    }
+
+    bool tryOrOpt(const int w, const double temperature, std::uniform_real_distribution<double>& uniform, long long& delta){
+        int len = 1 + rng_() % 3;
+        int segment[3];
+        segment[0] = 1 + rng_() % n_;
+        if (isFixed(segment[0])) return false;
+        for (int k = 1; k < len; k++){
+            segment[k] = next_[w][segment[k - 1]];
+            if (segment[k] == 0 || isFixed(segment[k])) return false;
+        }
+        int f = segment[0], l = segment[len - 1];
+        int p = prev_[w][f], q = next_[w][l];
+        int x = 1 + rng_() % n_;
+        int y = next_[w][x];
+        if (y == 0 || x == p || std::find(segment, segment + len, x) != segment + len) return false;
+
+        bool reversed = len > 1 && rng_() % 2;
+        const int removed[6]{p, f, l, q, x, y};
+        const int added[6]{p, q, x, reversed ? l : f, reversed ? f : l, y};
+        if (!accept(w, removed, added, 3, temperature, uniform, delta)) return false;
+
+        link(w, p, q);
+        if (reversed) std::reverse(segment, segment + len);
+        link(w, x, segment[0]);
+        for (int k = 0; k + 1 < len; k++) link(w, segment[k], segment[k + 1]);
+        link(w, segment[len - 1], y);
+        return true;
+    }
+
+    bool trySwap(const int w, const double temperature, std::uniform_real_distribution<double>& uniform, long long& delta){
+        int u = 1 + rng_() % n_;
+        int v = 1 + rng_() % n_;
+        if (u == v || isFixed(u) || isFixed(v)) return false;
+        if (next_[w][v] == u) std::swap(u, v);
+        int pu = prev_[w][u], nu = next_[w][u], pv = prev_[w][v], nv = next_[w][v];
+
+        if (nu == v){                                                                   // pu -> u -> v -> nv becomes pu -> v -> u -> nv.
+            const int removed[4]{pu, u, v, nv};
+            const int added[4]{pu, v, u, nv};
+            if (!accept(w, removed, added, 2, temperature, uniform, delta)) return false;
+            link(w, pu, v);
+            link(w, v, u);
+            link(w, u, nv);
+            return true;
+        }
+
+        const int removed[8]{pu, u, u, nu, pv, v, v, nv};
+        const int added[8]{pu, v, v, nu, pv, u, u, nv};
+        if (!accept(w, removed, added, 4, temperature, uniform, delta)) return false;
+        link(w, pu, v);
+        link(w, v, nu);
+        link(w, pv, u);
+        link(w, u, nv);
+        return true;
+    }
+
+    /**
+     * A new best is only marked in the journal: copying the tours on every improvement would
+     * cost O(n) per improving move. The best tours are rebuilt when the journal is flushed, from
+     * the current ones by undoing the relinks made since the mark, so saving costs O(1) amortized
+     * per relink (the journal is flushed at the end of a run, or once it holds 8(n + 1) relinks).
+     */
+    void noteBest(){
+        bestCost_ = cost_;
+        bestMark_ = journal_.size();
+    }
+
+    void flushJournal(){
+        if (bestMark_ != NO_MARK){
+            bestNext_[0] = next_[0];
+            bestNext_[1] = next_[1];
+            for (std::size_t k = journal_.size(); k > bestMark_; k--){
+                const Relink& relink = journal_[k - 1];
+                bestNext_[relink.w][relink.a] = relink.oldNext;
+            }
+            bestMark_ = NO_MARK;
+        }
+        journal_.clear();
+    }
+
+    struct Relink {
+        int w;
+        int a;
+        int oldNext;
+    };
+    static constexpr std::size_t NO_MARK = SIZE_MAX;
+
+    const int n_;
+    const bool closed_;
+    const bool requireOddDepth_;
+    std::mt19937 rng_;
+    std::vector<int> next_[2];
+    std::vector<int> prev_[2];
+    long long cost_;
+    long long bestCost_;
+    std::vector<int> bestNext_[2];                  // Best tours, as of the last flush.
+    std::vector<Relink> journal_;                   // Relinks since the last flush.
+    std::size_t bestMark_;                          // Journal size at a best not yet in bestNext_, or NO_MARK.
+};
+
+AnnealingOptions defaultAnnealingOptions(const int n){
+    int replicas = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    return {replicas, 100, 20LL * n, 0.3, 3.0, 1};
+}
+
+/**
+ * Implementation note:
+ * Replica r starts from the block construction. Temperature slot k holds the replica
+ * slot[k]; within an epoch every slot runs on its own thread. Between epochs, neighbouring
+ * slots (even or odd pairs, alternately) exchange replicas with probability
+ *     min(1, exp((1/T_k - 1/T_{k+1}) * (E_k - E_{k+1}))),
+ * which keeps each temperature's Boltzmann distribution stationary.
+ */
+static long long parallelTempering(const int n, const AnnealingOptions& options, const bool closed,
+                                   const bool requireOddDepth, std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(options.replicas >= 1 && options.minTemperature > 0 && options.maxTemperature >= options.minTemperature);
+    std::vector<int> start1, start2;
+    if (closed) constructDisjointCycles(n, start1, start2);
+    else constructDisjointPaths(n, start1, start2);
+
+    const int replicas = options.replicas;
+    std::vector<Replica> states;
+    std::vector<double> temperatures(replicas);
+    std::vector<int> slot(replicas);
+    for (int r = 0; r < replicas; r++){
+        states.emplace_back(n, closed, requireOddDepth, start1, start2, options.seed + r);
+        double fraction = (replicas > 1) ? (double) r / (replicas - 1) : 0.0;
+        temperatures.at(r) = options.minTemperature * std::pow(options.maxTemperature / options.minTemperature, fraction);
+        slot.at(r) = r;
+    }
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int epoch = 0; epoch < options.epochs; epoch++){
+        std::vector<std::thread> threads;
+        for (int k = 0; k < replicas; k++){
+            threads.emplace_back(&Replica::run, &states.at(slot.at(k)), options.movesPerEpoch, temperatures.at(k));
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        for (int k = epoch % 2; k + 1 < replicas; k += 2){
+            double energyGap = states.at(slot.at(k)).cost() - states.at(slot.at(k + 1)).cost();
+            double exponent = (1.0 / temperatures.at(k) - 1.0 / temperatures.at(k + 1)) * energyGap;
+            if (exponent >= 0 || uniform(rng) < std::exp(exponent)) std::swap(slot.at(k), slot.at(k + 1));
+        }
+    }
+
+    int best{0};
+    for (int r = 1; r < replicas; r++){
+        if (states.at(r).bestCost() < states.at(best).bestCost()) best = r;
+    }
+    states.at(best).bestTours(witness1, witness2);
+    return states.at(best).bestCost();
+}
+
+long long annealDisjointPaths(const int n, const AnnealingOptions& options,
+                              std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 6);
+    return parallelTempering(n, options, false, false, witness1, witness2);
+}
+
+long long annealDisjointCycles(const int n, const AnnealingOptions& options, const bool requireOddDepth,
+                               std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 8);
+    return parallelTempering(n, options, true, requireOddDepth, witness1, witness2);
+}
@@ -0,0 +1,265 @@
+/**
+ * @file local_search.cpp
+ * @brief Implementation of the local search heuristics on disjoint tour pairs.
+ *
+ * Each function declared in local_search.h is implemented here.
+ * Comments focus on the O(1) move evaluation and the invariants kept by every move.
+ */
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cassert>
+#include <hamiltonian_paths.h>
+#include <hamiltonian_cycles.h>
+#include <constructions.h>
+#include <local_search.h>
+
+/**
+ * Helper: 2-opt and Or-opt search over a pair of tours, modified in place.
+ *
+ * Moves are applied to one tour while the other is fixed, and are evaluated in O(1):
+ *   - 2-opt (i, j): replaces edges (t[i], t[i+1]) and (t[j], t[j+1]) by (t[i], t[j]) and
+ *     (t[i+1], t[j+1]), reversing t[i+1..j].
+ *   - Or-opt (s, len, k, reversed): moves the segment t[s..s+len-1] (len <= 3), possibly
+ *     reversed, between t[k] and t[k+1].
+ * Position 0 is never moved, so cycles keep 1 in front, and paths keep their endpoints.
+ *
+ * A move is feasible if none of its new edges belongs to the other tour (checked on the
+ * successor/predecessor arrays of the other tour) and, if required, it keeps the depth parity,
+ * which only depends on the replaced edges and the neighbours of 1 (see depthParityChange).
+ */
+class PairLocalSearch {
+public:
+    PairLocalSearch(std::vector<int>& tour1, std::vector<int>& tour2, const bool closed, const bool requireOddDepth)
+        : tours_{&tour1, &tour2}, closed_(closed), requireOddDepth_(requireOddDepth), n_(tour1.size()) {
+        assert(tour1.size() == tour2.size());
+        assert(!requireOddDepth || closed);
+    }
+
+    long long totalCost() const{
+        return closed_ ? (long long) computeCostCycle(*tours_[0]) + computeCostCycle(*tours_[1])
+                       : (long long) computeCostPath(*tours_[0]) + computeCostPath(*tours_[1]);
+    }
+
+    /**
+     * First-improvement descent, alternating tours, until a full pass finds nothing.
+     */
+    long long improve(){
+        long long moves{0};
+        bool improved{true};
+        while (improved){
+            improved = false;
+            for (int which = 0; which < 2; which++){
+                fixOther(which);
+                std::vector<int>& t = *tours_[which];
+                long long delta{0};
+
+                for (int i = 0; i <= lastEdge(); i++){
+                    for (int j = i + 2; j <= lastEdge(); j++){
+                        if (evaluateTwoOpt(t, i, j, delta) && delta < 0){
+                            applyTwoOpt(t, i, j);
+                            moves++;
+                            improved = true;
+                        }
+                    }
+                }
+
+                for (int len = 1; len <= 3; len++){
+                    for (int s = 1; s + len - 1 <= lastInner(); s++){
+                        for (int k = 0; k <= lastEdge(); k++){
+                            for (int reversed = 0; reversed < (len > 1 ? 2 : 1); reversed++){
+                                if (evaluateOrOpt(t, s, len, k, reversed, delta) && delta < 0){
+                                    applyOrOpt(t, s, len, k, reversed);
+                                    moves++;
+                                    improved = true;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return moves;
+    }
+
+    /**
+     * Applies count random feasible moves, regardless of their cost.
+     */
+    void kick(const int count, std::mt19937& rng){
+        long long delta{0};
+        int applied{0};
+        for (int attempt = 0; attempt < 100 * count && applied < count; attempt++){
+            int which = rng() % 2;
+            fixOther(which);
+            std::vector<int>& t = *tours_[which];
+            if (rng() % 2 == 0){
+                int i = rng() % (lastEdge() + 1);
+                int j = rng() % (lastEdge() + 1);
+                if (j < i + 2 || !evaluateTwoOpt(t, i, j, delta)) continue;
+                applyTwoOpt(t, i, j);
+            }
+            else {
+                int len = 1 + rng() % 3;
+                int s = 1 + rng() % lastInner();
+                int k = rng() % (lastEdge() + 1);
+                bool reversed = rng() % 2;
+                if (s + len - 1 > lastInner() || !evaluateOrOpt(t, s, len, k, reversed, delta)) continue;
+                applyOrOpt(t, s, len, k, reversed);
+            }
+            applied++;
+        }
+    }
+
+private:
+    // Last position i such that (t[i], t[i+1]) is an edge, and last movable position.
+    int lastEdge() const{ return closed_ ? n_ - 1 : n_ - 2; }
+    int lastInner() const{ return closed_ ? n_ - 1 : n_ - 2; }
+
+    int at(const std::vector<int>& t, const int position) const{ return t[position == n_ ? 0 : position]; }
+
+    int edgeCost(const int a, const int b) const{
+        int diff = std::abs(a - b);
+        return closed_ ? std::min(diff, n_ - diff) : diff;
+    }
+
+    bool isOtherEdge(const int a, const int b) const{
+        return successor_[a] == b || predecessor_[a] == b;
+    }
+
+    void fixOther(const int which){
+        const std::vector<int>& other = *tours_[1 - which];
+        if (closed_) buildCycleAdjacency(other, successor_, predecessor_);
+        else buildPathAdjacency(other, successor_, predecessor_);
+    }
+
+    bool feasible(const std::vector<int>& t, const int* removed, const int* added, const int edges) const{
+        for (int e = 0; e < edges; e++){
+            if (isOtherEdge(added[2 * e], added[2 * e + 1])) return false;
+        }
+        return !requireOddDepth_ || depthParityChange(n_, removed, added, edges, t[1], t[n_ - 1]) == 0;
+    }
+
+    long long costDelta(const int* removed, const int* added, const int edges) const{
+        long long delta{0};
+        for (int e = 0; e < edges; e++){
+            delta += edgeCost(added[2 * e], added[2 * e + 1]) - edgeCost(removed[2 * e], removed[2 * e + 1]);
+        }
+        return delta;
+    }
+
+    bool evaluateTwoOpt(const std::vector<int>& t, const int i, const int j, long long& delta) const{
+        if (closed_ && i == 0 && j == n_ - 1) return false;                            // The two edges share t[0].
+        int a = t[i], b = t[i + 1], c = t[j], d = at(t, j + 1);
+        const int removed[4]{a, b, c, d};
+        const int added[4]{a, c, b, d};
+        if (!feasible(t, removed, added, 2)) return false;
+        delta = costDelta(removed, added, 2);
+        return true;
+    }
+
+    void applyTwoOpt(std::vector<int>& t, const int i, const int j) const{
+        std::reverse(t.begin() + i + 1, t.begin() + j + 1);
+    }
+
+    bool evaluateOrOpt(const std::vector<int>& t, const int s, const int len, const int k, const bool reversed,
+                       long long& delta) const{
+        int e = s + len - 1;
+        if (k >= s - 1 && k <= e) return false;                                         // The target edge touches the segment.
+        int p = t[s - 1], f = t[s], l = t[e], q = at(t, e + 1);
+        int x = t[k], y = at(t, k + 1);
+        const int removed[6]{p, f, l, q, x, y};
+        const int added[6]{p, q, x, reversed ? l : f, reversed ? f : l, y};
+        if (!feasible(t, removed, added, 3)) return false;
+        delta = costDelta(removed, added, 3);
+        return true;
+    }
+
+    void applyOrOpt(std::vector<int>& t, const int s, const int len, const int k, const bool reversed) const{
+        if (reversed) std::reverse(t.begin() + s, t.begin() + s + len);                  // In place: no buffer per move.
+        if (k < s) std::rotate(t.begin() + k + 1, t.begin() + s, t.begin() + s + len);
+        else std::rotate(t.begin() + s, t.begin() + s + len, t.begin() + k + 1);
+    }
+
+    std::vector<int>* tours_[2];
+    const bool closed_;
+    const bool requireOddDepth_;
+    const int n_;
+    std::vector<int> successor_;
+    std::vector<int> predecessor_;
+};
+
+LocalSearchStats improveDisjointPaths(std::vector<int>& path1, std::vector<int>& path2){
+    assert(areDisjointPathsLinear(path1, path2));
+    PairLocalSearch search(path1, path2, false, false);
+    LocalSearchStats stats{search.totalCost(), 0, 0};
+    stats.moves = search.improve();
+    stats.finalCost = search.totalCost();
+    return stats;
+}
+
+LocalSearchStats improveDisjointCycles(std::vector<int>& cycle1, std::vector<int>& cycle2, const bool requireOddDepth){
+    assert(areDisjointCyclesLinear(cycle1, cycle2));
+    assert(!requireOddDepth || (isOddDepthCycle(cycle1) && isOddDepthCycle(cycle2)));
+    PairLocalSearch search(cycle1, cycle2, true, requireOddDepth);
+    LocalSearchStats stats{search.totalCost(), 0, 0};
+    stats.moves = search.improve();
+    stats.finalCost = search.totalCost();
+    cycle1 = canonicalCycle(cycle1);
+    cycle2 = canonicalCycle(cycle2);
+    return stats;
+}
+
+/**
+ * Helper: iterated local search from a constructed pair. Each round kicks a copy of the best
+ * pair with a few random feasible moves, descends, and keeps the result if it is no worse.
+ */
+static long long iteratedLocalSearch(const int n, const int iterations, const unsigned seed,
+                                     const bool closed, const bool requireOddDepth,
+                                     std::vector<int>& witness1, std::vector<int>& witness2){
+    if (closed) constructDisjointCycles(n, witness1, witness2);
+    else constructDisjointPaths(n, witness1, witness2);
+
+    PairLocalSearch best(witness1, witness2, closed, requireOddDepth);
+    best.improve();
+    long long bestCost = best.totalCost();
+
+    std::mt19937 rng(seed);
+    std::vector<int> candidate1, candidate2;
+    for (int iteration = 0; iteration < iterations; iteration++){
+        candidate1 = witness1;
+        candidate2 = witness2;
+        PairLocalSearch search(candidate1, candidate2, closed, requireOddDepth);
+        search.kick(2 + rng() % 4, rng);
+        search.improve();
+        long long cost = search.totalCost();
+        if (cost <= bestCost){
+            bestCost = cost;
+            witness1.swap(candidate1);
+            witness2.swap(candidate2);
+        }
+    }
+
+    if (closed){
+        witness1 = canonicalCycle(witness1);
+        witness2 = canonicalCycle(witness2);
+    }
+    return bestCost;
+}
+
+long long heuristicDisjointPaths(const int n, const int iterations, const unsigned seed,
+                                 std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 6);
+    return iteratedLocalSearch(n, iterations, seed, false, false, witness1, witness2);
+}
+
+/**
+ * Implementation note:
+ * The construction is only odd-depth for n >= 8, hence the stronger precondition.
+ */
+long long heuristicDisjointCycles(const int n, const int iterations, const unsigned seed, const bool requireOddDepth,
+                                  std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 8);
+    return iteratedLocalSearch(n, iterations, seed, true, requireOddDepth, witness1, witness2);
+}
@@ -0,0 +1,242 @@
+/**
+ * @file huge_pages.cpp
+ * @brief Implementation of huge-page backed allocation of the large search tables.
+ *
+ * Each function declared in huge_pages.h is implemented here.
+ * Comments focus on the fallback chain and on how the backing is measured.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <algorithm>
+#include <huge_pages.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/**
+ * Helper: state shared by all threads, guarded by one mutex (tables are few and large, so
+ * their allocation is never contended).
+ */
+struct Mapping {
+    std::size_t requested;
+    std::size_t mapped;
+    bool explicitPages;
+    unsigned long long serial;      // Tells apart successive tables mapped at the same address.
+    bool measured;
+    std::size_t transparentBytes;   // Last measurement, if measured.
+};
+
+static std::mutex registryMutex;
+static std::map<std::uintptr_t, Mapping> liveMappings;
+static unsigned long long nextSerial{0};
+static HugePageStats totals{0, 0, 0, 0, 0, 0};
+static HugePagePolicy currentPolicy = HugePagePolicy::Off;
+
+void setHugePagePolicy(const HugePagePolicy policy){
+    std::lock_guard<std::mutex> lock(registryMutex);
+    currentPolicy = policy;
+}
+
+HugePagePolicy hugePagePolicy(){
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return currentPolicy;
+}
+
+bool parseHugePagePolicy(const std::string& name, HugePagePolicy& policy){
+    if (name == "off") policy = HugePagePolicy::Off;
+    else if (name == "transparent") policy = HugePagePolicy::Transparent;
+    else if (name == "explicit") policy = HugePagePolicy::Explicit;
+    else return false;
+    return true;
+}
+
+std::size_t hugePageSize(){
+    static const std::size_t size = [](){
+        std::ifstream meminfo("/proc/meminfo");
+        std::string key;
+        std::size_t kib{0};
+        while (meminfo >> key){
+            if (key == "Hugepagesize:" && meminfo >> kib && kib > 0) return kib * 1024;
+            meminfo.ignore(1 << 10, '\n');
+        }
+        return (std::size_t) 2 << 20;
+    }();
+    return size;
+}
+
+/**
+ * Helper: a memory area of /proc/self/smaps and its AnonHugePages.
+ */
+struct SmapsArea {
+    std::uintptr_t start;
+    std::uintptr_t end;
+    std::size_t hugeBytes;
+};
+
+static std::vector<SmapsArea> readSmapsAreas(){
+    std::ifstream smaps("/proc/self/smaps");
+    std::vector<SmapsArea> areas;
+    std::string line;
+    while (std::getline(smaps, line)){
+        unsigned long low{0}, high{0};
+        char perms[5]{};
+        if (std::sscanf(line.c_str(), "%lx-%lx %4s", &low, &high, perms) == 3){
+            areas.push_back(SmapsArea{low, high, 0});
+            continue;
+        }
+        std::size_t kib{0};
+        if (areas.empty() || line.compare(0, 14, "AnonHugePages:") != 0) continue;
+        std::istringstream(line.substr(14)) >> kib;
+        areas.back().hugeBytes = kib * 1024;
+    }
+    return areas;
+}
+
+/**
+ * Implementation note:
+ * AnonHugePages in /proc/self/smaps counts the transparent huge pages of each memory area.
+ * The kernel may merge our mapping with an adjacent one that has the same flags, so an area
+ * is counted in proportion to its overlap with [start, end): exact unless merged areas are
+ * unevenly backed.
+ */
+static std::size_t transparentHugeBytes(const std::vector<SmapsArea>& areas, const std::uintptr_t start, const std::uintptr_t end){
+    double total{0};
+    for (const SmapsArea& area : areas){
+        if (area.end <= start || area.start >= end || area.hugeBytes == 0) continue;
+        double overlap = (double) (std::min(area.end, end) - std::max(area.start, start)) / (area.end - area.start);
+        total += overlap * area.hugeBytes;
+    }
+    return (std::size_t) total;
+}
+
+/**
+ * Implementation note:
+ * Explicit: MAP_HUGETLB needs the size in whole huge pages, and fails when the pool (see
+ * /proc/sys/vm/nr_hugepages) is too small. Transparent: the kernel only uses huge pages for
+ * aligned huge-page ranges, so one extra huge page is mapped and the unaligned ends are unmapped.
+ * The table is registered in both cases; a nullptr result counts as a regular allocation.
+ */
+void* allocateLargeTable(const std::size_t bytes){
+    const HugePagePolicy policy = hugePagePolicy();
+    const std::size_t page = hugePageSize();
+    const std::size_t mapped = (bytes + page - 1) / page * page;
+    void* table{nullptr};
+    bool explicitPages{false};
+
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+    if (policy == HugePagePolicy::Explicit){
+        void* area = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (area != MAP_FAILED){
+            table = area;
+            explicitPages = true;
+        }
+    }
+#endif
+    if (policy != HugePagePolicy::Off && table == nullptr){
+        void* area = mmap(nullptr, mapped + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (area != MAP_FAILED){
+            std::uintptr_t raw = reinterpret_cast<std::uintptr_t>(area);
+            std::uintptr_t aligned = (raw + page - 1) / page * page;
+            if (aligned > raw) munmap(area, aligned - raw);
+            if (raw + page > aligned) munmap(reinterpret_cast<void*>(aligned + mapped), raw + page - aligned);
+            table = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+            madvise(table, mapped, MADV_HUGEPAGE);
+#endif
+        }
+    }
+#endif
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    totals.tables++;
+    totals.requestedBytes += bytes;
+    if (table == nullptr){
+        totals.regularBytes += bytes;
+        return nullptr;
+    }
+    if (explicitPages) totals.explicitBytes += bytes;
+    liveMappings[reinterpret_cast<std::uintptr_t>(table)] = Mapping{bytes, mapped, explicitPages, nextSerial++, false, 0};
+    return table;
+}
+
+/**
+ * Implementation note:
+ * Releasing does not measure anything: the last measurement of hugePageStats, if any, is added
+ * to the totals, and the table counts as unmeasured otherwise.
+ */
+void releaseLargeTable(void* table){
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto entry = liveMappings.find(reinterpret_cast<std::uintptr_t>(table));
+    if (entry == liveMappings.end()) return;
+    const Mapping mapping = entry->second;
+    if (!mapping.explicitPages){
+        if (mapping.measured) totals.transparentBytes += mapping.transparentBytes;
+        else totals.unmeasuredBytes += mapping.requested;
+    }
+    liveMappings.erase(entry);
+#if defined(__linux__)
+    munmap(table, mapping.mapped);
+#endif
+}
+
+/**
+ * Implementation note:
+ * The live transparent mappings are listed under the lock, measured without it (smaps is read
+ * once for all of them), and the measurements are stored back under the lock for the mappings
+ * that are still the same tables (same address and serial).
+ */
+HugePageStats hugePageStats(){
+    std::vector<std::pair<std::uintptr_t, Mapping>> transparent;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& entry : liveMappings){
+            if (!entry.second.explicitPages) transparent.push_back(entry);
+        }
+    }
+    if (!transparent.empty()){
+        const std::vector<SmapsArea> areas = readSmapsAreas();
+        for (auto& entry : transparent){
+            entry.second.transparentBytes = std::min(entry.second.requested,
+                                                     transparentHugeBytes(areas, entry.first, entry.first + entry.second.mapped));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& measured : transparent){
+        auto entry = liveMappings.find(measured.first);
+        if (entry == liveMappings.end() || entry->second.serial != measured.second.serial) continue;
+        entry->second.measured = true;
+        entry->second.transparentBytes = measured.second.transparentBytes;
+    }
+    HugePageStats stats = totals;
+    for (const auto& entry : liveMappings){
+        if (entry.second.measured) stats.transparentBytes += entry.second.transparentBytes;
+    }
+    return stats;
+}
+
+std::string hugePageStatsLine(const HugePageStats& stats){
+    auto mib = [](const std::size_t bytes){
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << bytes / 1048576.0 << " MiB";
+        return out.str();
+    };
+    const char* names[]{"off", "transparent", "explicit"};
+    std::ostringstream line;
+    line << "Huge pages: " << stats.tables << " large tables, " << mib(stats.requestedBytes) << " requested, "
+         << mib(stats.explicitBytes + stats.transparentBytes) << " huge-page backed ("
+         << mib(stats.explicitBytes) << " explicit, " << mib(stats.transparentBytes) << " transparent, "
+         << mib(stats.unmeasuredBytes) << " released unmeasured), " << mib(stats.regularBytes) << " allocated normally (policy: " << names[(int) hugePagePolicy()] << ").";
+    return line.str();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file tour_arena.cpp
+ * @brief Implementation of the per-thread bump allocator.
+ *
+ * Each function declared in tour_arena.h is implemented here.
+ * Comments focus on how blocks are reused after a rewind.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cassert>
+#include <huge_pages.h>
+#include <tour_arena.h>
+
+TourArena::TourArena(const std::size_t blockBytes) : blockBytes_(blockBytes), current_(0), offset_(0) {}
+
+/**
+ * Implementation note:
+ * The request is served from the current block if it fits (after aligning the actual address),
+ * otherwise from the next free block, or from a new block inserted in front of the free blocks.
+ * Blocks are only ever added past the current position, so the marks taken before stay valid.
+ * Only oversized blocks of a huge page or more are mapped by allocateLargeTable: with the default
+ * 4 MiB blocks, every regular block would otherwise count as a large table.
+ */
+void* TourArena::allocate(const std::size_t bytes, const std::size_t alignment){
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    auto fit = [&](const Block& block, const std::size_t from) -> std::size_t {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.data.get()) + from;
+        std::size_t padding = (alignment - address % alignment) % alignment;
+        return (from + padding + bytes <= block.size) ? from + padding : SIZE_MAX;
+    };
+
+    if (current_ < blocks_.size()){
+        std::size_t start = fit(blocks_[current_], offset_);
+        if (start != SIZE_MAX){
+            offset_ = start + bytes;
+            return blocks_[current_].data.get() + start;
+        }
+    }
+
+    std::size_t next = (current_ < blocks_.size() && offset_ > 0) ? current_ + 1 : current_;
+    if (next >= blocks_.size() || fit(blocks_[next], 0) == SIZE_MAX){
+        std::size_t size = std::max(blockBytes_, bytes + alignment);
+        bool oversized = size > blockBytes_ && size >= hugePageSize();
+        unsigned char* data = oversized ? static_cast<unsigned char*>(allocateLargeTable(size)) : nullptr;
+        bool mapped = data != nullptr;
+        if (!mapped) data = new unsigned char[size];
+        blocks_.insert(blocks_.begin() + next, Block{std::unique_ptr<unsigned char, Release>(data, Release{mapped}), size});
+    }
+    current_ = next;
+    std::size_t start = fit(blocks_[current_], 0);
+    offset_ = start + bytes;
+    return blocks_[current_].data.get() + start;
+}
+
+void TourArena::Release::operator()(unsigned char* data) const{
+    if (mapped) releaseLargeTable(data);
+    else delete[] data;
+}
+
+TourArena::Mark TourArena::mark() const{
+    return Mark{current_, offset_};
+}
+
+/**
+ * Implementation note:
+ * Blocks past the mark become free (including the block of the mark if nothing of it is in use).
+ * The oversized ones (typically the storage of one large tour table) are freed right away, so a
+ * thread does not keep the peak of its largest search. A mark past the current position belongs
+ * to memory given back already, by a scope ended out of order.
+ */
+void TourArena::rewind(const Mark& mark){
+    assert(mark.block <= blocks_.size() && (mark.block < blocks_.size() || mark.offset == 0));
+    assert(mark.block < current_ || (mark.block == current_ && mark.offset <= offset_));    // Not already given back.
+    std::size_t firstFree = (mark.offset == 0) ? mark.block : mark.block + 1;
+    for (std::size_t b = firstFree; b < blocks_.size(); ){
+        if (blocks_[b].size > blockBytes_) blocks_.erase(blocks_.begin() + b);
+        else b++;
+    }
+    current_ = mark.block;
+    offset_ = mark.offset;
+}
+
+void TourArena::reset(){
+    rewind(Mark{0, 0});
+}
+
+std::size_t TourArena::bytesInUse() const{
+    std::size_t used{0};
+    for (std::size_t b = 0; b < current_ && b < blocks_.size(); b++) used += blocks_[b].size;   // Tails of filled blocks count as used.
+    return used + offset_;
+}
+
+std::size_t TourArena::bytesReserved() const{
+    std::size_t reserved{0};
+    for (const Block& block : blocks_) reserved += block.size;
+    return reserved;
+}
+
+TourArena& threadArena(){
+    thread_local TourArena arena;
+    return arena;
+}
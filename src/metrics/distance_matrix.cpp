@@ -0,0 +1,212 @@
+/**
+ * @file distance_matrix.cpp
+ * @brief Implementation of distance matrices and of the disjoint tour searches on them.
+ *
+ * Each function declared in distance_matrix.h is implemented here.
+ * Comments focus on the input formats and the rounding conventions.
+ */
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <climits>
+#include <algorithm>
+#include <bound.h>
+#include <pair_engine.h>
+#include <distance_matrix.h>
+
+/**
+ * Implementation note:
+ * A tour has at most n edges, so weights up to INT_MAX / (2n) keep the total cost of any pair
+ * of tours within an int, the type of the cost tables of PairEngine.
+ */
+bool isValidDistanceMatrix(const DistanceMatrix& matrix, const bool requireSymmetric){
+    const int n = matrix.n;
+    if (n < 2 || n > DISTANCE_MATRIX_MAX_N || (long long) matrix.weights.size() != (long long) n * n) return false;
+    const int maxWeight = INT_MAX / (2 * n);
+    for (int a = 1; a <= n; a++){
+        if (matrix.at(a, a) != 0) return false;
+        for (int b = 1; b <= n; b++){
+            if (matrix.at(a, b) < 0 || matrix.at(a, b) > maxWeight) return false;
+            if (requireSymmetric && matrix.at(a, b) != matrix.at(b, a)) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Helper: builds a matrix from a distance function on the labels 1, ..., n.
+ */
+template <typename Distance>
+static DistanceMatrix buildDistanceMatrix(const int n, const Distance& distance){
+    DistanceMatrix matrix{n, std::vector<int>((long long) n * n)};
+    for (int a = 1; a <= n; a++){
+        for (int b = 1; b <= n; b++) matrix.weights[(a - 1) * n + (b - 1)] = (a == b) ? 0 : distance(a, b);
+    }
+    return matrix;
+}
+
+DistanceMatrix lineDistanceMatrix(const int n){
+    return buildDistanceMatrix(n, [](int a, int b){ return std::abs(a - b); });
+}
+
+DistanceMatrix circleDistanceMatrix(const int n){
+    return buildDistanceMatrix(n, [n](int a, int b){ return std::min(std::abs(a - b), n - std::abs(a - b)); });
+}
+
+/**
+ * Helper: TSPLIB distance functions on 2D points (x[a - 1], y[a - 1]).
+ * EUC_2D rounds to the nearest integer, CEIL_2D rounds up, and ATT is the pseudo-Euclidean
+ * distance sqrt((dx^2 + dy^2) / 10), rounded up unless it is already an integer after rounding.
+ */
+static DistanceMatrix pointsDistanceMatrix(const std::vector<double>& x, const std::vector<double>& y,
+                                           const std::string& type){
+    return buildDistanceMatrix(x.size(), [&](int a, int b){
+        double dx = x[a - 1] - x[b - 1], dy = y[a - 1] - y[b - 1];
+        if (type == "CEIL_2D") return (int) std::ceil(std::sqrt(dx * dx + dy * dy));
+        if (type == "ATT"){
+            double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+            int t = (int) (r + 0.5);
+            return (t < r) ? t + 1 : t;
+        }
+        return (int) (std::sqrt(dx * dx + dy * dy) + 0.5);
+    });
+}
+
+DistanceMatrix gridDistanceMatrix(const int rows, const int columns, const int spacing){
+    std::vector<double> x, y;
+    for (int r = 0; r < rows; r++){
+        for (int c = 0; c < columns; c++){
+            x.push_back((double) c * spacing);
+            y.push_back((double) r * spacing);
+        }
+    }
+    return pointsDistanceMatrix(x, y, "EUC_2D");
+}
+
+DistanceMatrix randomPointsDistanceMatrix(const int n, const int side, const unsigned seed){
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coordinate(0, side);
+    std::vector<double> x(n), y(n);
+    for (int a = 0; a < n; a++){
+        x[a] = coordinate(rng);
+        y[a] = coordinate(rng);
+    }
+    return pointsDistanceMatrix(x, y, "EUC_2D");
+}
+
+/**
+ * Helper: whether n is a supported size and the rest of the file is long enough to hold the
+ * given number of whitespace-separated entries (at least two bytes each, but the last), checked
+ * before the tables of a header are allocated.
+ */
+static bool headerFitsFile(std::ifstream& in, const long long n, const long long entries){
+    if (n < 2 || n > DISTANCE_MATRIX_MAX_N) return false;
+    const std::streampos position = in.tellg();
+    if (position < 0 || !in.seekg(0, std::ios::end)) return false;
+    const long long remaining = (long long) in.tellg() - position;
+    in.seekg(position);
+    return in && remaining >= 2 * entries - 1;
+}
+
+bool readDistanceMatrix(const std::string& filename, DistanceMatrix& matrix, const bool requireSymmetric){
+    std::ifstream in(filename);
+    if (!in || !(in >> matrix.n) || !headerFitsFile(in, matrix.n, (long long) matrix.n * matrix.n)) return false;
+    matrix.weights.assign((long long) matrix.n * matrix.n, 0);
+    for (int& weight : matrix.weights){
+        if (!(in >> weight)) return false;
+    }
+    return isValidDistanceMatrix(matrix, requireSymmetric);
+}
+
+/**
+ * Implementation note:
+ * The specification part is a list of "KEY : VALUE" lines (the colon may be glued to the key).
+ * Explicit weights are read as a flat list of numbers and placed according to the format:
+ * for a row-wise triangle, the pairs (a, b) are visited row by row, with b > a (UPPER_ROW),
+ * b >= a (UPPER_DIAG_ROW), b < a (LOWER_ROW) or b <= a (LOWER_DIAG_ROW), and mirrored.
+ * Any other format (column-wise triangles, a misspelling, or no format at all) is rejected,
+ * rather than read as a matrix of zeros. Only ATSP instances may be asymmetric.
+ */
+bool readTsplibInstance(const std::string& filename, DistanceMatrix& matrix){
+    std::ifstream in(filename);
+    if (!in) return false;
+
+    int n{0};
+    std::string type, weightType, weightFormat, line;
+    while (std::getline(in, line)){
+        std::string key = line.substr(0, line.find(':'));
+        std::string value = (line.find(':') == std::string::npos) ? "" : line.substr(line.find(':') + 1);
+        key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
+        value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+
+        if (key == "TYPE") type = value;
+        else if (key == "DIMENSION") n = std::atoi(value.c_str());
+        else if (key == "EDGE_WEIGHT_TYPE") weightType = value;
+        else if (key == "EDGE_WEIGHT_FORMAT") weightFormat = value;
+        else if (key == "NODE_COORD_SECTION"){
+            if (weightType != "EUC_2D" && weightType != "CEIL_2D" && weightType != "ATT") return false;
+            if (!headerFitsFile(in, n, 3LL * n)) return false;
+            std::vector<double> x(n), y(n);
+            for (int k = 0; k < n; k++){
+                int label{0};
+                if (!(in >> label >> x[k] >> y[k]) || label != k + 1) return false;
+            }
+            matrix = pointsDistanceMatrix(x, y, weightType);
+            return isValidDistanceMatrix(matrix);
+        }
+        else if (key == "EDGE_WEIGHT_SECTION"){
+            if (weightType != "EXPLICIT") return false;
+            if (weightFormat != "FULL_MATRIX" && weightFormat != "UPPER_ROW" && weightFormat != "LOWER_ROW" &&
+                weightFormat != "UPPER_DIAG_ROW" && weightFormat != "LOWER_DIAG_ROW") return false;
+            long long entries = (weightFormat == "FULL_MATRIX") ? (long long) n * n : (long long) n * (n - 1) / 2;
+            if (weightFormat == "UPPER_DIAG_ROW" || weightFormat == "LOWER_DIAG_ROW") entries += n;
+            if (!headerFitsFile(in, n, entries)) return false;
+            matrix = DistanceMatrix{n, std::vector<int>((long long) n * n, 0)};
+            for (int a = 1; a <= n; a++){
+                for (int b = 1; b <= n; b++){
+                    bool stored = (weightFormat == "FULL_MATRIX") || (weightFormat == "UPPER_ROW" && b > a) ||
+                                  (weightFormat == "UPPER_DIAG_ROW" && b >= a) || (weightFormat == "LOWER_ROW" && b < a) ||
+                                  (weightFormat == "LOWER_DIAG_ROW" && b <= a);
+                    if (!stored) continue;
+                    int weight{0};
+                    if (!(in >> weight)) return false;
+                    matrix.weights[(a - 1) * n + (b - 1)] = weight;
+                    if (weightFormat != "FULL_MATRIX") matrix.weights[(b - 1) * n + (a - 1)] = weight;
+                }
+            }
+            return isValidDistanceMatrix(matrix, type != "ATSP");
+        }
+    }
+    return false;
+}
+
+bool findDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed, const Bound& bound,
+                               std::vector<int>& witness1, std::vector<int>& witness2){
+    const long long maxCost = bound.maxAdmissibleCost();
+    if (closed) return PairEngine<MatrixTopology<true>>(matrix.n, false, maxCost, {&matrix}).findFirst(witness1, witness2);
+    return PairEngine<MatrixTopology<false>>(matrix.n, false, maxCost, {&matrix}).findFirst(witness1, witness2);
+}
+
+long long minDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed,
+                                   std::vector<int>& witness1, std::vector<int>& witness2){
+    if (closed) return PairEngine<MatrixTopology<true>>(matrix.n, false, LLONG_MAX, {&matrix}).findMinimum(witness1, witness2);
+    return PairEngine<MatrixTopology<false>>(matrix.n, false, LLONG_MAX, {&matrix}).findMinimum(witness1, witness2);
+}
+
+bool findArcDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed, const Bound& bound,
+                                  std::vector<int>& witness1, std::vector<int>& witness2){
+    const long long maxCost = bound.maxAdmissibleCost();
+    if (closed) return PairEngine<DirectedMatrixTopology<true>>(matrix.n, false, maxCost, {&matrix}).findFirst(witness1, witness2);
+    return PairEngine<DirectedMatrixTopology<false>>(matrix.n, false, maxCost, {&matrix}).findFirst(witness1, witness2);
+}
+
+long long minArcDisjointToursInMatrix(const DistanceMatrix& matrix, const bool closed,
+                                      std::vector<int>& witness1, std::vector<int>& witness2){
+    if (closed) return PairEngine<DirectedMatrixTopology<true>>(matrix.n, false, LLONG_MAX, {&matrix}).findMinimum(witness1, witness2);
+    return PairEngine<DirectedMatrixTopology<false>>(matrix.n, false, LLONG_MAX, {&matrix}).findMinimum(witness1, witness2);
+}
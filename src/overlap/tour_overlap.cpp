@@ -0,0 +1,97 @@
+/**
+ * @file tour_overlap.cpp
+ * @brief Implementation of the all-pairs edge overlap of a pool of tours.
+ *
+ * Each function declared in tour_overlap.h is implemented here.
+ * Comments focus on the layout of the edge index.
+ */
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <iterator>
+#include <tour_overlap.h>
+
+/**
+ * Helper: key of the undirected edge {a, b}, the same in both directions.
+ */
+static unsigned long long edgeKey(const int a, const int b){
+    return ((unsigned long long) (uint32_t) std::min(a, b) << 32) | (uint32_t) std::max(a, b);
+}
+
+static int edgeCount(const std::vector<int>& tour, const bool closed){
+    if (tour.size() < 2) return 0;
+    return closed ? tour.size() : tour.size() - 1;
+}
+
+/**
+ * Implementation note:
+ * The pass over the pool gives each new edge the next slot number, and records one (slot, tour)
+ * incidence per edge of a tour (lastTour[slot] drops repeats within a tour). A counting sort by
+ * slot then lays out the tours of every edge contiguously, in increasing order, so the upper
+ * triangle is filled by scanning each edge's tours, and mirrored at the end.
+ */
+OverlapMatrix computeOverlapMatrix(const std::vector<std::vector<int>>& tours, const bool closed){
+    const int count = tours.size();
+    OverlapMatrix matrix{count, std::vector<int>((std::size_t) count * count, 0), 0, 0};
+    long long totalEdges{0};
+    for (const std::vector<int>& tour : tours) totalEdges += edgeCount(tour, closed);
+
+    std::unordered_map<unsigned long long, int> slots;
+    slots.reserve(totalEdges);
+    std::vector<int> lastTour, slotSize;
+    std::vector<std::pair<int, int>> incidences;                                        // (slot, tour)
+    incidences.reserve(totalEdges);
+    for (int t = 0; t < count; t++){
+        const std::vector<int>& tour = tours[t];
+        const int edges = edgeCount(tour, closed);
+        for (int k = 0; k < edges; k++){
+            auto inserted = slots.emplace(edgeKey(tour[k], tour[(k + 1) % tour.size()]), (int) lastTour.size());
+            const int slot = inserted.first->second;
+            if (inserted.second){
+                lastTour.push_back(-1);
+                slotSize.push_back(0);
+            }
+            if (lastTour[slot] == t) continue;
+            lastTour[slot] = t;
+            slotSize[slot]++;
+            incidences.emplace_back(slot, t);
+        }
+    }
+    matrix.distinctEdges = slotSize.size();
+
+    std::vector<long long> offset(slotSize.size() + 1, 0);
+    for (std::size_t slot = 0; slot < slotSize.size(); slot++) offset[slot + 1] = offset[slot] + slotSize[slot];
+    std::vector<int> members(incidences.size());
+    std::vector<long long> next(offset.begin(), offset.end() - 1);
+    for (const std::pair<int, int>& incidence : incidences) members[next[incidence.first]++] = incidence.second;
+
+    for (std::size_t slot = 0; slot < slotSize.size(); slot++){
+        for (long long a = offset[slot]; a < offset[slot + 1]; a++){
+            int* row = matrix.shared.data() + (long long) members[a] * count;
+            row[members[a]]++;
+            for (long long b = a + 1; b < offset[slot + 1]; b++) row[members[b]]++;
+            matrix.pairUpdates += offset[slot + 1] - a - 1;
+        }
+    }
+    for (int i = 0; i < count; i++){
+        for (int j = i + 1; j < count; j++) matrix.shared[(long long) j * count + i] = matrix.shared[(long long) i * count + j];
+    }
+    return matrix;
+}
+
+int countSharedEdges(const std::vector<int>& tour1, const std::vector<int>& tour2, const bool closed){
+    std::vector<unsigned long long> edges[2];
+    const std::vector<int>* tours[2] = {&tour1, &tour2};
+    for (int side = 0; side < 2; side++){
+        const std::vector<int>& tour = *tours[side];
+        for (int k = 0; k < edgeCount(tour, closed); k++) edges[side].push_back(edgeKey(tour[k], tour[(k + 1) % tour.size()]));
+        std::sort(edges[side].begin(), edges[side].end());
+        edges[side].erase(std::unique(edges[side].begin(), edges[side].end()), edges[side].end());
+    }
+    std::vector<unsigned long long> common;
+    std::set_intersection(edges[0].begin(), edges[0].end(), edges[1].begin(), edges[1].end(), std::back_inserter(common));
+    return common.size();
+}
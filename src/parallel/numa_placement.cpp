@@ -0,0 +1,178 @@
+/**
+ * @file numa_placement.cpp
+ * @brief Implementation of the NUMA placement helpers of the parallel pair search.
+ *
+ * Each function declared in numa_placement.h is implemented here.
+ * Comments focus on the sysfs formats and on the remote access estimate.
+ */
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <numa_placement.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Implementation note:
+ * A CPU list is a comma-separated list of single CPUs and inclusive ranges "a-b".
+ */
+std::vector<int> parseCpuList(const std::string& list){
+    std::vector<int> cpus;
+    std::stringstream items(list);
+    std::string item;
+    while (std::getline(items, item, ',')){
+        item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+        if (item.empty()) continue;
+        int first{-1}, last{-1};
+        char dash{0};
+        std::istringstream range(item);
+        if (!(range >> first) || first < 0) return {};
+        if (range >> dash){
+            if (dash != '-' || !(range >> last) || last < first) return {};
+        }
+        else last = first;
+        for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+/**
+ * Helper: CPUs the process may run on.
+ */
+static std::vector<int> allowedCpus(){
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0){
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++){
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    if (cpus.empty()){
+        for (int cpu = 0; cpu < (int) std::max(1u, std::thread::hardware_concurrency()); cpu++) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/**
+ * Implementation note:
+ * /sys/devices/system/node/online lists the nodes (in the CPU list format), and
+ * nodeK/cpulist the CPUs of node K. Nodes without an allowed CPU (memory-only nodes, or
+ * excluded by the affinity mask) are dropped.
+ */
+NumaTopology detectNumaTopology(){
+    const std::vector<int> allowed = allowedCpus();
+    NumaTopology topology;
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string nodeList;
+    if (online && std::getline(online, nodeList)){
+        for (int node : parseCpuList(nodeList)){
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string cpuList;
+            if (!file || !std::getline(file, cpuList)) continue;
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(cpuList)){
+                if (std::binary_search(allowed.begin(), allowed.end(), cpu)) cpus.push_back(cpu);
+            }
+            if (!cpus.empty()) topology.cpus.push_back(cpus);
+        }
+    }
+    if (topology.cpus.empty()) topology.cpus.push_back(allowed);
+    return topology;
+}
+
+/**
+ * Implementation note:
+ * Each worker goes to the node with the fewest workers per CPU so far (lowest index on ties),
+ * and takes the next CPU of that node.
+ */
+std::vector<WorkerPlacement> placeWorkers(const NumaTopology& topology, const int threads){
+    std::vector<WorkerPlacement> placements;
+    std::vector<int> assigned(topology.nodes(), 0);
+    for (int w = 0; w < threads; w++){
+        int best{0};
+        for (int node = 1; node < topology.nodes(); node++){
+            // assigned[node] / size(node) < assigned[best] / size(best), without division.
+            if ((long long) assigned[node] * topology.cpus[best].size() < (long long) assigned[best] * topology.cpus[node].size()) best = node;
+        }
+        const std::vector<int>& cpus = topology.cpus[best];
+        placements.push_back(WorkerPlacement{best, cpus[assigned[best] % cpus.size()]});
+        assigned[best]++;
+    }
+    return placements;
+}
+
+bool pinCurrentThread(const int cpu){
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void) cpu;
+    return false;
+#endif
+}
+
+int currentCpu(){
+#if defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+int numaNodeOfCpu(const NumaTopology& topology, const int cpu){
+    for (int node = 0; node < topology.nodes(); node++){
+        if (std::binary_search(topology.cpus[node].begin(), topology.cpus[node].end(), cpu)) return node;
+    }
+    return 0;
+}
+
+int currentNumaNode(const NumaTopology& topology){
+    return numaNodeOfCpu(topology, currentCpu());
+}
+
+/**
+ * Implementation note:
+ * Worker t gets the rows i = t, t + W, ..., and row i reads the rows i, ..., rows - 1 (its own
+ * to build the mask, then the others). With k such rows, the reads of worker t add up to
+ *     sum over r < k of (rows - t - rW) = k (rows - t) - W k (k - 1) / 2.
+ * All the reads of a worker go to the table of its node, so they are all local or all remote.
+ * This ignores the cost pruning, which skips rows independently of the placement.
+ */
+double estimateRemoteAccessRatio(const long long rows, const std::vector<WorkerPlacement>& placements,
+                                 const std::vector<int>& tableNodes){
+    const long long workers = placements.size();
+    double total{0}, remote{0};
+    for (long long t = 0; t < workers && t < rows; t++){
+        double k = (double) ((rows - t + workers - 1) / workers);
+        double reads = k * (rows - t) - workers * k * (k - 1) / 2;
+        total += reads;
+        if (tableNodes.at(t) != placements.at(t).node) remote += reads;
+    }
+    return (total > 0) ? remote / total : 0;
+}
+
+std::string parallelReportLine(const ParallelReport& report){
+    std::ostringstream line;
+    line << "Parallel search: " << report.threads << " threads on " << report.nodes << " node"
+         << (report.nodes == 1 ? "" : "s") << ", " << report.pinnedThreads << " pinned, "
+         << report.replicas << " table replica" << (report.replicas == 1 ? "" : "s")
+         << ", estimated remote reads ";
+    if (report.remoteAccessRatio < 0) line << "unknown (threads not pinned).";
+    else line << std::fixed << std::setprecision(1) << 100 * report.remoteAccessRatio << "%.";
+    return line.str();
+}
@@ -0,0 +1,72 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the fixed pool of worker threads.
+ *
+ * Each function declared in thread_pool.h is implemented here.
+ * Comments focus on the hand-off between run() and the workers.
+ */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <thread_pool.h>
+
+ThreadPool::ThreadPool(const int threads)
+    : task_(nullptr), tasks_(0), next_(0), pending_(0), batch_(0), stopping_(false) {
+    const int count = (threads > 0) ? threads : std::max(1u, std::thread::hardware_concurrency());
+    for (int w = 0; w < count; w++) workers_.emplace_back([this](){ work(); });
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+}
+
+int ThreadPool::size() const{
+    return workers_.size();
+}
+
+/**
+ * Implementation note:
+ * A batch is published under the mutex with a new batch number, which is what wakes the workers.
+ * Each task index is taken under the mutex too: tasks are whole rows of work, so the lock is
+ * never contended. pending_ counts the tasks not yet finished, and the last one wakes run().
+ */
+void ThreadPool::run(const int tasks, const std::function<void(int)>& task){
+    if (tasks <= 0) return;
+    std::lock_guard<std::mutex> serialize(runMutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_ = &task;
+    tasks_ = tasks;
+    next_ = 0;
+    pending_ = tasks;
+    batch_++;
+    wake_.notify_all();
+    done_.wait(lock, [this](){ return pending_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::work(){
+    unsigned long long seen{0};
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true){
+        wake_.wait(lock, [this, &seen](){ return stopping_ || batch_ != seen; });
+        if (stopping_) return;
+        seen = batch_;
+        while (next_ < tasks_){
+            const int index = next_++;
+            const std::function<void(int)>& task = *task_;
+            lock.unlock();
+            task(index);
+            lock.lock();
+            if (--pending_ == 0) done_.notify_all();
+        }
+    }
+}
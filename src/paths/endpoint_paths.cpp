@@ -0,0 +1,58 @@
+/**
+ * @file endpoint_paths.cpp
+ * @brief Implementation of the all-endpoints table of minimum disjoint path costs.
+ *
+ * Each function declared in endpoint_paths.h is implemented here.
+ * Comments focus on which endpoint buckets are searched and on the memory they hold.
+ */
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <atomic>
+#include <cassert>
+#include <pair_engine.h>
+#include <endpoint_paths.h>
+
+/**
+ * Implementation note:
+ * The reflection v -> n + 1 - v preserves every edge cost |a - b| and maps the (s, t)-paths onto
+ * the (n + 1 - s, n + 1 - t)-paths, so the buckets {s, t} and {n + 1 - t, n + 1 - s} have the same
+ * minimum and only the first of each such pair is searched (about half of the n(n - 1)/2).
+ * Buckets are streamed: a worker takes the next bucket from a shared counter, enumerates its
+ * (n - 2)! paths in a PairEngine<LineTopologyBetween> (whose tables have an arena of their own), and the tables are given
+ * back before the next bucket. At most one bucket per thread is in memory at any time, instead of
+ * all n!/2 paths.
+ */
+std::vector<std::vector<long long>> minDisjointPathCostsForAllEndpoints(const int n, int threads){
+    assert(n >= 2);
+    std::vector<std::pair<int, int>> buckets;
+    for (int s = 1; s <= n; s++){
+        for (int t = s + 1; t <= n; t++){
+            if (std::make_pair(s, t) <= std::make_pair(n + 1 - t, n + 1 - s)) buckets.emplace_back(s, t);
+        }
+    }
+
+    std::vector<std::vector<long long>> table(n + 1, std::vector<long long>(n + 1, -1));
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<int>(threads, buckets.size());
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; w++){
+        workers.emplace_back([&](){
+            std::vector<int> witness1, witness2;
+            for (int b = next++; b < (int) buckets.size(); b = next++){
+                const int s = buckets[b].first, t = buckets[b].second;
+                long long cost = PairEngine<LineTopologyBetween>(n, false, LLONG_MAX, {s, t}).findMinimum(witness1, witness2);
+                table.at(s).at(t) = cost;                                               // Cells of distinct buckets.
+                table.at(t).at(s) = cost;
+                table.at(n + 1 - t).at(n + 1 - s) = cost;
+                table.at(n + 1 - s).at(n + 1 - t) = cost;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    return table;
+}
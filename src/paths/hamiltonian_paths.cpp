@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <numeric>
 #include <cassert>
+#include <bound.h>
 #include <hamiltonian_paths.h>
 
 /**
@@ -32,10 +33,10 @@ int computeCostPath(const std::vector<int>& path){
  * Implementation note:
  * Adds the costs of two paths and compares with the given threshold.
  */
-bool arePathsWithinBound(const std::vector<int>& path1, const std::vector<int>& path2, const double bound){
+bool arePathsWithinBound(const std::vector<int>& path1, const std::vector<int>& path2, const Bound& bound){
     int costPath1 = computeCostPath(path1);
     int costPath2 = computeCostPath(path2);
-    return (costPath1 + costPath2 < bound);
+    return bound.admits(costPath1 + costPath2);
 }
 
 /**
@@ -70,14 +71,74 @@ bool areDisjointPaths(const std::vector<int>& path1, const std::vector<int>& pat
     return true;
 }
 
+/**
+ * Implementation note:
+ * Same as areDisjointPaths, but an arc of path1 only matches an arc of path2 in the same direction.
+ */
+bool areArcDisjointPaths(const std::vector<int>& path1, const std::vector<int>& path2){
+    assert(path1.size() == path2.size());
+    int n = path1.size();
+    for (int i = 1; i < n; i++){
+        for (int k = 1; k < n; k++){
+            if (path1.at(i - 1) == path2.at(k - 1) && path1.at(i) == path2.at(k)) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Implementation note:
+ * successor[v] and predecessor[v] are the neighbours of v along the path, with 0 standing
+ * for "none" at the two endpoints (index 0 is unused). The arrays are resized only if too
+ * small, so the same buffers can be reused across many paths.
+ */
+void buildPathAdjacency(const std::vector<int>& path, std::vector<int>& successor, std::vector<int>& predecessor){
+    int n = path.size();
+    if ((int) successor.size() < n + 1) successor.resize(n + 1);
+    if ((int) predecessor.size() < n + 1) predecessor.resize(n + 1);
+
+    for (int i = 0; i < n; i++){
+        successor.at(path.at(i)) = (i + 1 < n) ? path.at(i + 1) : 0;
+        predecessor.at(path.at(i)) = (i > 0) ? path.at(i - 1) : 0;
+    }
+}
+
+/**
+ * Implementation note:
+ * An edge (a, b) belongs to the path described by the arrays if and only if b is the
+ * successor or the predecessor of a, which is an O(1) test; labels are never 0, so the
+ * endpoint sentinels never match.
+ */
+bool pathAvoidsAdjacency(const std::vector<int>& path, const std::vector<int>& successor, const std::vector<int>& predecessor){
+    int n = path.size();
+    for (int i = 1; i < n; i++){
+        int tail = path.at(i - 1);
+        int head = path.at(i);
+        if (successor.at(tail) == head || predecessor.at(tail) == head) return false;
+    }
+    return true;
+}
+
+/**
+ * Implementation note:
+ * Linear-time counterpart of areDisjointPaths: path1 is converted to adjacency arrays
+ * once, instead of scanning it for every edge of path2.
+ */
+bool areDisjointPathsLinear(const std::vector<int>& path1, const std::vector<int>& path2){
+    assert(path1.size() == path2.size());
+    std::vector<int> successor, predecessor;
+    buildPathAdjacency(path1, successor, predecessor);
+    return pathAvoidsAdjacency(path2, successor, predecessor);
+}
+
 /**
  * Implementation note:
  * Enumerates all Hamiltonian paths of size n, represented as
  * permutations of [n] with endpoints fixed at 1 and n.
  * Uses std::next_permutation to generate candidates.
- * Tests all pairs for disjointness.
  */
-bool disjointPathsExist(const int n){
+std::vector<std::vector<int>> enumeratePaths(const int n){
+    assert(n >= 2);
     // Create and populate the identity permutation (1, 2, ..., n)
     std::vector<int> identity(n);
     std::iota(identity.begin(), identity.end(), 1);
@@ -88,11 +149,66 @@ bool disjointPathsExist(const int n){
         allPaths.push_back(identity);
     } while (std::next_permutation(identity.begin() + 1, identity.end() - 1));
 
+    return allPaths;
+}
+
+/**
+ * Implementation note:
+ * A path (1, sigma, n) of [n] is extended by inserting n into one of the |sigma| + 1 gaps
+ * of the interior sigma and appending the new endpoint n + 1. Since every permutation of
+ * {2, ..., n} arises exactly once by inserting n into a permutation of {2, ..., n - 1},
+ * this yields every path of [n + 1] exactly once.
+ * Line costs do not depend on n, so the child cost follows from the parent cost in O(1):
+ * relabelling the endpoint n as n + 1 adds 1 (its neighbour is smaller than n), and
+ * inserting n between a and b adds |a - n| + |n - b| - |a - b|.
+ */
+std::vector<std::vector<int>> extendPathsByInsertion(const std::vector<std::vector<int>>& paths,
+                                                     const std::vector<int>& costs,
+                                                     std::vector<int>& extendedCosts){
+    assert(paths.size() == costs.size());
+    std::vector<std::vector<int>> extended;
+    extendedCosts.clear();
+    if (paths.empty()) return extended;
+
+    int n = paths.at(0).size();
+    extended.reserve(paths.size() * (n - 1));
+    extendedCosts.reserve(paths.size() * (n - 1));
+    std::vector<int> child(n + 1);
+    for (int p = 0; p < (int) paths.size(); p++){
+        const std::vector<int>& path = paths.at(p);
+        assert(path.at(0) == 1 && path.at(n - 1) == n);
+        for (int gap = 1; gap <= n - 1; gap++){                                          // Insert n right before position gap.
+            std::copy(path.begin(), path.begin() + gap, child.begin());
+            child.at(gap) = n;
+            std::copy(path.begin() + gap, path.end() - 1, child.begin() + gap + 1);
+            child.at(n) = n + 1;
+
+            int before = child.at(gap - 1);
+            int after = child.at(gap + 1);
+            extendedCosts.push_back(costs.at(p) + 1 + std::abs(before - n) + std::abs(n - after) - std::abs(before - after));
+            extended.push_back(child);
+        }
+    }
+    return extended;
+}
+
+/**
+ * Implementation note:
+ * Enumerates all Hamiltonian paths of size n (see enumeratePaths).
+ * Tests all pairs for disjointness, and reports the first disjoint pair found.
+ */
+bool findDisjointPaths(const int n, std::vector<int>& witness1, std::vector<int>& witness2){
+    std::vector<std::vector<int>> allPaths = enumeratePaths(n);
+
     // Test every pair of paths for disjointness
     int m = allPaths.size();
     for (int i = 0; i < m; i++){
         for (int j = i + 1; j < m; j++){
-            if (areDisjointPaths(allPaths.at(i), allPaths.at(j))) return true;
+            if (areDisjointPaths(allPaths.at(i), allPaths.at(j))){
+                witness1 = allPaths.at(i);
+                witness2 = allPaths.at(j);
+                return true;
+            }
         }
     }
 
@@ -101,28 +217,118 @@ bool disjointPathsExist(const int n){
 
 /**
  * Implementation note:
- * Same as disjointPathsExist, but requires the total cost of the two disjoint
+ * Same as findDisjointPaths, but requires the total cost of the two disjoint
  * paths to be below the given threshold.
+ * Path costs are computed once up front and the bound is turned into an integer
+ * threshold, so the pair loop only does an integer comparison before falling back
+ * to the (expensive) disjointness test.
  */
-bool disjointPathsExistWithinBound(const int n, const double bound){
-    // Create and populate the identity permutation (1, 2, ..., n)
-    std::vector<int> identity(n);
-    std::iota(identity.begin(), identity.end(), 1);
+bool findDisjointPathsWithinBound(const int n, const Bound& bound, std::vector<int>& witness1, std::vector<int>& witness2){
+    std::vector<std::vector<int>> allPaths = enumeratePaths(n);
+
+    // Precompute path costs and the largest admissible total cost
+    int m = allPaths.size();
+    std::vector<int> costs(m);
+    for (int i = 0; i < m; i++) costs.at(i) = computeCostPath(allPaths.at(i));
+    const long long maxCost = bound.maxAdmissibleCost();
+
+    // Test every pair of paths for total cost within the bound and for disjointness
+    for (int i = 0; i < m; i++){
+        for (int j = i + 1; j < m; j++){
+            if (costs.at(i) + costs.at(j) > maxCost) continue;
+
+            const std::vector<int>& path1 = allPaths.at(i);
+            const std::vector<int>& path2 = allPaths.at(j);
+
+            if (areDisjointPaths(path1, path2)){
+                witness1 = path1;
+                witness2 = path2;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Implementation note:
+ * Thin wrappers over the witness-reporting searches that discard the witness.
+ */
+bool disjointPathsExist(const int n){
+    std::vector<int> witness1, witness2;
+    return findDisjointPaths(n, witness1, witness2);
+}
+
+bool disjointPathsExistWithinBound(const int n, const Bound& bound){
+    std::vector<int> witness1, witness2;
+    return findDisjointPathsWithinBound(n, bound, witness1, witness2);
+}
+
+
+/**
+ * Implementation note:
+ * Same as enumeratePaths, with s in front, t at the back, and the other vertices in between.
+ * For s = 1 and t = n, the paths come in the same order as enumeratePaths.
+ */
+std::vector<std::vector<int>> enumeratePathsBetween(const int n, const int s, const int t){
+    assert(n >= 2 && s >= 1 && s <= n && t >= 1 && t <= n && s != t);
+    std::vector<int> path{s};
+    for (int v = 1; v <= n; v++){
+        if (v != s && v != t) path.push_back(v);
+    }
+    path.push_back(t);
 
-    // Create and populate a list of all permutations of [n] with endpoints 1 and n  
     std::vector<std::vector<int>> allPaths;
     do{
-        allPaths.push_back(identity);
-    } while (std::next_permutation(identity.begin() + 1, identity.end() - 1));
+        allPaths.push_back(path);
+    } while (std::next_permutation(path.begin() + 1, path.end() - 1));
+
+    return allPaths;
+}
+
+/**
+ * Implementation note:
+ * Same pair loops as findDisjointPaths and findDisjointPathsWithinBound, over the paths of
+ * enumeratePathsBetween(n, s, t).
+ */
+bool findDisjointPathsBetween(const int n, const int s, const int t,
+                              std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 2 && s >= 1 && s <= n && t >= 1 && t <= n && s != t);
+    std::vector<std::vector<int>> allPaths = enumeratePathsBetween(n, s, t);
 
-    // Test every pair of paths for disjointness and for total cost within 16*(n - 1)/5
     int m = allPaths.size();
     for (int i = 0; i < m; i++){
         for (int j = i + 1; j < m; j++){
-            std::vector<int> path1 = allPaths.at(i);
-            std::vector<int> path2 = allPaths.at(j);
+            if (areDisjointPaths(allPaths.at(i), allPaths.at(j))){
+                witness1 = allPaths.at(i);
+                witness2 = allPaths.at(j);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool findDisjointPathsBetweenWithinBound(const int n, const int s, const int t, const Bound& bound,
+                                         std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 2 && s >= 1 && s <= n && t >= 1 && t <= n && s != t);
+    std::vector<std::vector<int>> allPaths = enumeratePathsBetween(n, s, t);
+
+    int m = allPaths.size();
+    std::vector<int> costs(m);
+    for (int i = 0; i < m; i++) costs.at(i) = computeCostPath(allPaths.at(i));
+    const long long maxCost = bound.maxAdmissibleCost();
 
-            if (areDisjointPaths(path1, path2) && arePathsWithinBound(path1, path2, bound)) return true;
+    for (int i = 0; i < m; i++){
+        for (int j = i + 1; j < m; j++){
+            if (costs.at(i) + costs.at(j) > maxCost) continue;
+            if (areDisjointPaths(allPaths.at(i), allPaths.at(j))){
+                witness1 = allPaths.at(i);
+                witness2 = allPaths.at(j);
+                return true;
+            }
         }
     }
 
@@ -0,0 +1,168 @@
+/**
+ * @file anytime_search.cpp
+ * @brief Implementation of the budgeted, resumable minimum-cost pair search.
+ *
+ * Each function declared in anytime_search.h is implemented here.
+ * Comments focus on the visiting order and the lower bound it proves.
+ */
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <climits>
+#include <numeric>
+#include <algorithm>
+#include <cassert>
+#include <hamiltonian_paths.h>
+#include <hamiltonian_cycles.h>
+#include <pair_engine.h>
+#include <anytime_search.h>
+
+/**
+ * Helper: the tours of a search, sorted by cost, in the PairEngine of its topology (only the
+ * one of the search is set).
+ */
+struct AnytimeTables {
+    std::unique_ptr<PairEngine<ListedTopology<LineTopology>>> paths;
+    std::unique_ptr<PairEngine<ListedTopology<CircleTopology>>> cycles;
+};
+
+/**
+ * Helper: sorts the tours by cost (stable, so the order is reproducible) and sets up an
+ * empty search whose lower bound is the cost of the two cheapest tours.
+ */
+static AnytimeSearch prepareSearch(const bool closed, const int n, std::vector<std::vector<int>> tours){
+    AnytimeSearch search;
+    search.closed = closed;
+    search.n = n;
+
+    std::vector<int> costs(tours.size());
+    for (int i = 0; i < (int) tours.size(); i++){
+        costs.at(i) = closed ? computeCostCycle(tours.at(i)) : computeCostPath(tours.at(i));
+    }
+    std::vector<int> order(tours.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](int a, int b){ return costs.at(a) < costs.at(b); });
+    std::vector<std::vector<int>> sorted;
+    for (int index : order){
+        sorted.push_back(std::move(tours.at(index)));
+        search.costs.push_back(costs.at(index));
+    }
+
+    std::shared_ptr<AnytimeTables> tables(new AnytimeTables());
+    if (closed) tables->cycles.reset(new PairEngine<ListedTopology<CircleTopology>>(n, false, LLONG_MAX, {&sorted}));
+    else tables->paths.reset(new PairEngine<ListedTopology<LineTopology>>(n, false, LLONG_MAX, {&sorted}));
+    search.tables = tables;
+
+    search.outer = 0;
+    search.inner = 1;
+    search.nodes = 0;
+    search.bestCost = -1;
+    search.complete = search.costs.size() < 2;
+    search.lowerBound = search.complete ? LLONG_MAX : (long long) search.costs.at(0) + search.costs.at(1);
+    return search;
+}
+
+AnytimeSearch startAnytimePathSearch(const int n){
+    assert(n >= 2);
+    return prepareSearch(false, n, enumeratePaths(n));
+}
+
+AnytimeSearch startAnytimeCycleSearch(const int n, const bool requireOddDepth){
+    assert(n >= 3);
+    std::vector<std::vector<int>> cycles = enumerateCycles(n);
+    if (requireOddDepth){
+        cycles.erase(std::remove_if(cycles.begin(), cycles.end(),
+                                    [](const std::vector<int>& cycle){ return !isOddDepthCycle(cycle); }),
+                     cycles.end());
+    }
+    return prepareSearch(true, n, cycles);
+}
+
+void seedAnytimeSearch(AnytimeSearch& search, const std::vector<int>& tour1, const std::vector<int>& tour2){
+    assert((int) tour1.size() == search.n && (int) tour2.size() == search.n);
+    assert(search.closed ? areDisjointCyclesLinear(tour1, tour2) : areDisjointPathsLinear(tour1, tour2));
+    long long cost = search.closed ? (long long) computeCostCycle(tour1) + computeCostCycle(tour2)
+                                   : (long long) computeCostPath(tour1) + computeCostPath(tour2);
+    if (search.bestCost >= 0 && cost >= search.bestCost) return;
+    search.bestCost = cost;
+    search.witness1 = tour1;
+    search.witness2 = tour2;
+    search.lowerBound = std::min(search.lowerBound, cost);
+}
+
+/**
+ * Implementation note:
+ * Tours are sorted by cost, c_0 <= c_1 <= ... <= c_{m-1}, and pairs (i, j), i < j, are visited
+ * in lexicographic order. Only pairs cheaper than the best one so far are tested, so for a
+ * fixed i the scan over j stops at the first j with c_i + c_j >= best, and the whole search
+ * stops at the first i with c_i + c_{i+1} >= best.
+ *
+ * Lower bound: when the budget runs out before testing (i, j), every pair not yet ruled out
+ * is either (i, j') with j' >= j, of cost >= c_i + c_j, or (i', j') with j' > i' > i, of cost
+ * >= c_{i+1} + c_{i+2}. Pairs already visited are not disjoint or not cheaper than the best.
+ * So the optimum is at least min(best, c_i + c_j, c_{i+1} + c_{i+2}).
+ *
+ * The pairs of a row are tested by the row step of PairEngine, in chunks that end where the
+ * budget must be checked again: after the remaining node budget, and every 1024 nodes for the
+ * time limit. So the search stops at exactly the same pair as when testing pair by pair.
+ */
+template <class Engine>
+static bool advanceSearch(AnytimeSearch& search, const Engine& engine, const SearchBudget& budget){
+    auto start = std::chrono::steady_clock::now();
+    const long long m = search.costs.size();
+    const std::vector<int>& costs = search.costs;
+    long long spent{0};
+
+    while (search.outer < m - 1){
+        const long long i = search.outer;
+        const long long best = (search.bestCost < 0) ? LLONG_MAX : search.bestCost;
+        if (costs.at(i) + costs.at(i + 1) >= best) break;
+
+        // Partners from rowEnd on are not cheaper than the best pair (costs are sorted).
+        const long long rowEnd = (search.bestCost < 0) ? m
+                                 : std::lower_bound(costs.begin() + search.inner, costs.end(), search.bestCost - costs.at(i)) - costs.begin();
+        while (search.inner < rowEnd){
+            const long long j = search.inner;
+            bool outOfNodes = budget.maxNodes > 0 && spent >= budget.maxNodes;
+            bool outOfTime = budget.maxSeconds > 0 && spent % 1024 == 0 && spent > 0 &&
+                             std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= budget.maxSeconds;
+            if (outOfNodes || outOfTime){
+                long long bound = (long long) costs.at(i) + costs.at(j);
+                if (i + 2 < m) bound = std::min(bound, (long long) costs.at(i + 1) + costs.at(i + 2));
+                if (search.bestCost >= 0) bound = std::min(bound, search.bestCost);
+                search.lowerBound = std::max(search.lowerBound, bound);                     // Both are valid bounds.
+                return false;
+            }
+
+            long long chunkEnd = rowEnd;
+            if (budget.maxNodes > 0) chunkEnd = std::min(chunkEnd, j + budget.maxNodes - spent);
+            if (budget.maxSeconds > 0) chunkEnd = std::min(chunkEnd, j + 1024 - spent % 1024);
+            const long long disjoint = engine.forEachDisjointInRow(i, j, chunkEnd, [](int){ return true; },
+                                                                   [](int){ return false; });
+            const long long tested = (disjoint < chunkEnd) ? disjoint - j + 1 : chunkEnd - j;
+            spent += tested;
+            search.nodes += tested;
+            if (disjoint < chunkEnd){
+                search.bestCost = costs.at(i) + costs.at(disjoint);
+                search.witness1 = engine.tour(i);
+                search.witness2 = engine.tour(disjoint);
+                break;                                                                  // Later j cannot be cheaper.
+            }
+            search.inner = chunkEnd;
+        }
+
+        search.outer++;
+        search.inner = search.outer + 1;
+    }
+
+    search.complete = true;
+    search.lowerBound = (search.bestCost < 0) ? LLONG_MAX : search.bestCost;
+    return true;
+}
+
+bool continueAnytimeSearch(AnytimeSearch& search, const SearchBudget& budget){
+    if (search.complete) return true;
+    return search.closed ? advanceSearch(search, *search.tables->cycles, budget)
+                         : advanceSearch(search, *search.tables->paths, budget);
+}
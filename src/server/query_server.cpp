@@ -0,0 +1,301 @@
+/**
+ * @file query_server.cpp
+ * @brief Implementation of the long-running query server.
+ *
+ * Each function declared in query_server.h is implemented here.
+ * Comments focus on the request grammar and on the lifetime of socket clients.
+ */
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <istream>
+#include <ostream>
+#include <cstring>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <bound.h>
+#include <session.h>
+#include <query_server.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Longest request line accepted from a socket client before it is disconnected.
+static const std::size_t MAX_REQUEST_BYTES = 1 << 16;
+
+/**
+ * Helper: reads a whole token as an integer.
+ */
+static bool parseInteger(const std::string& token, long long& value){
+    std::istringstream in(token);
+    char extra;
+    return (in >> value) && !(in >> extra);
+}
+
+/**
+ * Helper: reads a bound "p" or "p/q" with q > 0, and both within BOUND_MAX in absolute value.
+ */
+static bool parseBound(const std::string& token, Bound& bound){
+    const std::size_t slash = token.find('/');
+    long long p, q{1};
+    if (!parseInteger(token.substr(0, slash), p)) return false;
+    if (slash != std::string::npos && (!parseInteger(token.substr(slash + 1), q) || q <= 0)) return false;
+    if (p < -BOUND_MAX || p > BOUND_MAX || q > BOUND_MAX) return false;                  // Outside the domain of Bound.
+    bound = Bound(p, q);
+    return true;
+}
+
+static std::string tourToString(const std::vector<int>& tour){
+    if (tour.empty()) return "-";
+    std::string text;
+    for (int k = 0; k < (int) tour.size(); k++) text += (k > 0 ? "," : "") + std::to_string(tour[k]);
+    return text;
+}
+
+/**
+ * Helper: request line without surrounding whitespace (such as the '\r' of a telnet client).
+ */
+static std::string trimmed(const std::string& line){
+    const char* space = " \t\r\n";
+    const std::size_t first = line.find_first_not_of(space);
+    if (first == std::string::npos) return "";
+    return line.substr(first, line.find_last_not_of(space) - first + 1);
+}
+
+/**
+ * Implementation note:
+ * A request is a command, then "<topology> <n>" for the queries, then an optional bound. The
+ * bounded circle queries are the odd-depth ones, as in the rest of the code (runCachedQuery,
+ * countDisjointCyclesWithinBound), so that a warm answer may come from the shared cache file.
+ */
+std::string answerRequest(Session& session, const std::string& request){
+    std::istringstream in(request);
+    std::vector<std::string> tokens;
+    for (std::string token; in >> token;) tokens.push_back(token);
+    if (tokens.empty()) return "error empty request";
+    const std::string& command = tokens[0];
+    if (command == "quit" || command == "shutdown") return "";
+    std::ostringstream answer;
+    if (command == "stats"){
+        SessionStats stats = session.stats();
+        answer << "ok queries=" << stats.queries << " cache_hits=" << stats.cacheHits << " tour_sets_built="
+               << stats.tourSetsBuilt << " tour_sets_reused=" << stats.tourSetsReused << " threads=" << session.threads();
+        return answer.str();
+    }
+    if (command != "exists" && command != "within_bound" && command != "count" && command != "min"){
+        return "error unknown command " + command;
+    }
+
+    const bool bounded = (command == "within_bound" || (command == "count" && tokens.size() == 4));
+    const std::size_t expected = bounded ? 4 : 3;
+    if (tokens.size() != expected) return "error expected " + command + " <line|circle> <n>" + (bounded ? " <p[/q]>" : "");
+    const std::string& topology = tokens[1];
+    if (topology != "line" && topology != "circle") return "error unknown topology " + topology;
+    long long n;
+    if (!parseInteger(tokens[2], n) || n < 3 || n > SERVER_MAX_N) return "error n must be in [3, " + std::to_string(SERVER_MAX_N) + "]";
+    Bound bound(0);
+    if (bounded && !parseBound(tokens[3], bound)) return "error invalid bound " + tokens[3];
+
+    QueryKey key{topology, (int) n, bounded ? "within_bound" : "exists", bound, bounded && topology == "circle"};
+    if (command == "count"){
+        answer << "ok count=" << session.countPairs(key);
+    }
+    else if (command == "min"){
+        std::vector<int> witness1, witness2;
+        long long cost = session.minimumCost(topology, (int) n, false, witness1, witness2);
+        answer << "ok cost=" << cost << " witness1=" << tourToString(witness1) << " witness2=" << tourToString(witness2);
+    }
+    else {
+        QueryResult result = session.query(key);
+        answer << "ok exists=" << result.exists << " witness1=" << tourToString(result.witness1)
+               << " witness2=" << tourToString(result.witness2) << " seconds=" << result.seconds;
+    }
+    return answer.str();
+}
+
+int serveStream(Session& session, std::istream& in, std::ostream& out){
+    std::string line;
+    while (std::getline(in, line)){
+        const std::string request = trimmed(line);
+        if (request.empty()) continue;
+        if (request == "quit" || request == "shutdown") break;
+        out << answerRequest(session, request) << std::endl;                            // Flushed: the client waits for it.
+    }
+    return 0;
+}
+
+/**
+ * Helper: writes a whole buffer to a socket (without SIGPIPE if the client is gone).
+ */
+static bool sendAll(const int socket, const std::string& data){
+    std::size_t sent{0};
+    while (sent < data.size()){
+        ssize_t written = send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        sent += written;
+    }
+    return true;
+}
+
+/**
+ * Helper: serves one socket client until it quits or disconnects, or the server stops.
+ * The client socket is polled with a timeout, so an idle client does not hold up shutdown.
+ */
+static void serveClient(Session& session, const int client, std::atomic<bool>& stopping){
+    std::string buffer;
+    char chunk[4096];
+    bool closing{false};
+    while (!closing && !stopping){
+        pollfd ready{client, POLLIN, 0};
+        int events = poll(&ready, 1, 100);
+        if (events < 0 && errno == EINTR) continue;
+        if (events < 0) break;
+        if (events == 0) continue;
+        ssize_t received = recv(client, chunk, sizeof(chunk), 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) break;
+        buffer.append(chunk, received);
+        std::size_t end;
+        while (!closing && (end = buffer.find('\n')) != std::string::npos){
+            const std::string request = trimmed(buffer.substr(0, end));
+            buffer.erase(0, end + 1);
+            if (request.empty()) continue;
+            if (request == "shutdown") stopping = true;
+            if (request == "quit" || request == "shutdown") closing = true;
+            else if (!sendAll(client, answerRequest(session, request) + "\n")) closing = true;
+        }
+        if (buffer.size() > MAX_REQUEST_BYTES) closing = true;
+    }
+    close(client);
+}
+
+/**
+ * Helper: Unix socket address of a path, if the path fits.
+ */
+static bool socketAddress(const std::string& path, sockaddr_un& address){
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return true;
+}
+
+/**
+ * Helper: removes a stale socket file at path. Anything else there (a regular file, a directory,
+ * a symbolic link) is left alone.
+ * @return true if there is nothing at path any more, false if something other than a socket is there.
+ */
+static bool removeSocketFile(const std::string& path){
+    struct stat info;
+    if (lstat(path.c_str(), &info) != 0) return errno == ENOENT;
+    if (!S_ISSOCK(info.st_mode)) return false;
+    return unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+/**
+ * Implementation note:
+ * The socket file of an earlier server is replaced, but the server refuses to start over any
+ * other file, so that a wrong --socket path never deletes data.
+ * The listening socket is polled with a timeout so that the loop notices a shutdown request.
+ * Each client runs on its own thread; finished threads are joined as new clients arrive, and
+ * the remaining ones when the server stops.
+ */
+int serveUnixSocket(Session& session, const std::string& path){
+    sockaddr_un address;
+    if (!socketAddress(path, address)) return 1;
+    if (!removeSocketFile(path)) return 1;
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) return 1;
+    if (bind(listener, (const sockaddr*) &address, sizeof(address)) != 0 || listen(listener, 64) != 0){
+        close(listener);
+        return 1;
+    }
+
+    struct ClientThread {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+    std::list<ClientThread> clients;
+    std::atomic<bool> stopping(false);
+    while (!stopping){
+        for (auto it = clients.begin(); it != clients.end();){
+            if (!*it->finished){
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            it = clients.erase(it);
+        }
+        pollfd ready{listener, POLLIN, 0};
+        if (poll(&ready, 1, 100) <= 0) continue;
+        const int client = accept(listener, nullptr, nullptr);
+        if (client < 0) continue;
+        std::shared_ptr<std::atomic<bool>> finished(new std::atomic<bool>(false));
+        clients.push_back(ClientThread{std::thread([&session, &stopping, client, finished](){
+            serveClient(session, client, stopping);
+            *finished = true;
+        }), finished});
+    }
+    close(listener);
+    removeSocketFile(path);
+    for (ClientThread& client : clients) client.thread.join();
+    return 0;
+}
+
+/**
+ * Implementation note:
+ * The requests are written by a second thread while this one reads the answers: a client that
+ * wrote a large batch before reading could fill both socket buffers and wait for the server
+ * forever. Answers are expected up to the first quit or shutdown.
+ */
+bool sendRequests(const std::string& path, const std::vector<std::string>& requests, std::vector<std::string>& answers){
+    answers.clear();
+    sockaddr_un address;
+    if (!socketAddress(path, address)) return false;
+    const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) return false;
+    if (connect(server, (const sockaddr*) &address, sizeof(address)) != 0){
+        close(server);
+        return false;
+    }
+    std::string data;
+    std::size_t expected{0};
+    bool closing{false};
+    for (const std::string& request : requests){
+        const std::string text = trimmed(request);
+        data += request + "\n";
+        if (text == "quit" || text == "shutdown") closing = true;
+        else if (!closing && !text.empty()) expected++;
+    }
+    bool sent{false};
+    std::thread writer([&](){
+        sent = sendAll(server, data);
+        shutdown(server, SHUT_WR);
+    });
+
+    std::string buffer;
+    char chunk[4096];
+    ssize_t received;
+    while ((received = recv(server, chunk, sizeof(chunk), 0)) != 0){
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0) break;
+        buffer.append(chunk, received);
+    }
+    writer.join();
+    close(server);
+    std::istringstream lines(buffer);
+    for (std::string line; std::getline(lines, line);) answers.push_back(line);
+    return sent && answers.size() == expected;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file session.cpp
+ * @brief Implementation of the long-lived query session.
+ *
+ * Each function declared in session.h is implemented here.
+ * Comments focus on which tables a query reuses, on what is memoized, and on locking.
+ */
+
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <utility>
+#include <mutex>
+#include <future>
+#include <exception>
+#include <chrono>
+#include <climits>
+#include <cassert>
+#include <pair_engine.h>
+#include <thread_pool.h>
+#include <result_cache.h>
+#include <session.h>
+
+/**
+ * Helper: the tables of one (topology, n, odd-depth). The engine owns the arena of its tables,
+ * so they outlive the scope of the query that built them.
+ */
+template <class Topology>
+struct TourSet {
+    std::unique_ptr<PairEngine<Topology>> engine;
+};
+
+/**
+ * Helper: cheapest pair of a (topology, n, odd-depth).
+ */
+struct MinimumCost {
+    long long cost;
+    std::vector<int> witness1;
+    std::vector<int> witness2;
+};
+
+/**
+ * Implementation note:
+ * mutex guards the maps and the statistics, never a search nor a table build: a query takes the
+ * tables it needs and looks up its answer under the lock, searches without it, and stores the
+ * answer under it again. A table set is published as a shared future under the lock: the first
+ * query of a key builds it after releasing the lock, and the later ones wait on the future, so
+ * memo hits and statistics never wait for a build. Tables are shared, so releaseTourSets only
+ * drops the session's references while running searches keep theirs. Counts of concurrent
+ * queries share the pool, whose batches run one after the other.
+ */
+struct Session::State {
+    template <class Topology>
+    using PendingSet = std::shared_future<std::shared_ptr<TourSet<Topology>>>;
+
+    SessionOptions options;
+    ThreadPool pool;
+    std::mutex mutex;
+    std::map<int, PendingSet<LineTopology>> lines;                                      // By n (no depth filter on the line).
+    std::map<std::pair<int, bool>, PendingSet<CircleTopology>> circles;                 // By (n, odd-depth).
+    std::map<std::string, QueryResult> results;                                         // By queryKeyString.
+    std::map<std::string, long long> counts;                                            // By queryKeyString.
+    std::map<std::string, MinimumCost> minima;
+    SessionStats stats;
+
+    explicit State(const SessionOptions& sessionOptions)
+        : options(sessionOptions), pool(sessionOptions.threads), stats{0, 0, 0, 0} {}
+
+    /**
+     * Tables of a key, built if needed. Called with lock held, returns with it released.
+     * A failed build is dropped from the map, and its waiters get the exception.
+     */
+    template <class Topology, class Key>
+    std::shared_ptr<TourSet<Topology>> tourSet(std::unique_lock<std::mutex>& lock, std::map<Key, PendingSet<Topology>>& sets,
+                                               const Key& key, const int n, const bool depthFilter){
+        auto found = sets.find(key);
+        if (found != sets.end()){
+            stats.tourSetsReused++;
+            PendingSet<Topology> pending = found->second;
+            lock.unlock();
+            return pending.get();
+        }
+        std::promise<std::shared_ptr<TourSet<Topology>>> promise;
+        sets[key] = promise.get_future().share();
+        stats.tourSetsBuilt++;
+        lock.unlock();
+        try {
+            std::shared_ptr<TourSet<Topology>> set(new TourSet<Topology>());
+            set->engine.reset(new PairEngine<Topology>(n, depthFilter, LLONG_MAX));
+            promise.set_value(set);
+            return set;
+        }
+        catch (...){
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> relock(mutex);
+            sets.erase(key);
+            throw;
+        }
+    }
+
+    /**
+     * Runs search on the engine of the tours of (topology, n), built without any cost limit:
+     * the limit of each query is passed to the search instead. Called without mutex held.
+     */
+    template <class Search>
+    auto withEngine(const std::string& topology, const int n, const bool depthFilter, Search search){
+        assert(topology == "line" || topology == "circle");
+        std::unique_lock<std::mutex> lock(mutex);
+        if (topology == "line") return search(*tourSet(lock, lines, n, n, false)->engine);
+        return search(*tourSet(lock, circles, std::make_pair(n, depthFilter), n, depthFilter)->engine);
+    }
+};
+
+/**
+ * Helper: cost limit of a query ("exists" has none).
+ */
+static long long queryLimit(const QueryKey& key){
+    return (key.mode == "exists") ? LLONG_MAX : key.bound.maxAdmissibleCost();
+}
+
+Session::Session(const SessionOptions& options) : state_(new State(options)) {}
+
+Session::~Session() = default;
+
+/**
+ * Implementation note:
+ * The keys accepted are those of runCachedQuery (the bounded circle search is the odd-depth one),
+ * so that both write the same answers under the same key in a shared cache file.
+ */
+QueryResult Session::query(const QueryKey& key){
+    assert(key.mode == "exists" || key.mode == "within_bound");
+    assert(key.topology == "circle" || !key.oddDepth);
+    assert(key.topology == "line" || key.mode == "exists" || key.oddDepth);
+    const std::string keyString = queryKeyString(key);
+    QueryResult result;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stats.queries++;
+        auto memo = state_->results.find(keyString);
+        if (memo != state_->results.end()){
+            state_->stats.cacheHits++;
+            return memo->second;
+        }
+        if (lookupCachedResult(state_->options.cacheFile, key, result)){
+            state_->stats.cacheHits++;
+            return state_->results[keyString] = result;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const bool depthFilter = (key.mode == "within_bound" && key.oddDepth);
+    result.exists = state_->withEngine(key.topology, key.n, depthFilter, [&](const auto& engine){
+        return engine.findFirst(queryLimit(key), result.witness1, result.witness2);
+    });
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->results.emplace(keyString, result).second) storeCachedResult(state_->options.cacheFile, key, result);
+    return result;
+}
+
+/**
+ * Implementation note:
+ * Counts are only memoized in memory: the cache file format holds existence answers.
+ */
+long long Session::countPairs(const QueryKey& key){
+    assert(key.mode == "exists" || key.mode == "within_bound");
+    assert(key.topology == "circle" || !key.oddDepth);
+    const std::string keyString = queryKeyString(key);
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stats.queries++;
+        auto memo = state_->counts.find(keyString);
+        if (memo != state_->counts.end()){
+            state_->stats.cacheHits++;
+            return memo->second;
+        }
+    }
+    const bool depthFilter = (key.mode == "within_bound" && key.oddDepth);
+    long long found = state_->withEngine(key.topology, key.n, depthFilter, [&](const auto& engine){
+        return engine.count(state_->pool, queryLimit(key));
+    });
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->counts[keyString] = found;
+}
+
+long long Session::minimumCost(const std::string& topology, const int n, const bool oddDepth,
+                               std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(topology == "circle" || !oddDepth);
+    const std::string keyString = topology + " n=" + std::to_string(n) + " odd=" + std::to_string(oddDepth);
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stats.queries++;
+        auto memo = state_->minima.find(keyString);
+        if (memo != state_->minima.end()){
+            state_->stats.cacheHits++;
+            witness1 = memo->second.witness1;
+            witness2 = memo->second.witness2;
+            return memo->second.cost;
+        }
+    }
+    MinimumCost minimum;
+    minimum.cost = state_->withEngine(topology, n, oddDepth, [&](const auto& engine){
+        return engine.findMinimum(LLONG_MAX, minimum.witness1, minimum.witness2);
+    });
+    witness1 = minimum.witness1;
+    witness2 = minimum.witness2;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->minima.emplace(keyString, minimum);
+    return minimum.cost;
+}
+
+void Session::releaseTourSets(){
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->lines.clear();
+    state_->circles.clear();
+}
+
+int Session::threads() const{
+    return state_->pool.size();
+}
+
+SessionStats Session::stats() const{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->stats;
+}
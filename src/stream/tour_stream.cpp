@@ -0,0 +1,295 @@
+/**
+ * @file tour_stream.cpp
+ * @brief Implementation of the streaming tour pair reader and writers.
+ *
+ * Each function declared in tour_stream.h is implemented here.
+ * Comments focus on the O(n) per-pair checks and the file handling.
+ */
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pair_engine.h>
+#include <tour_stream.h>
+
+static_assert(sizeof(int) == sizeof(int32_t), "binary tour files store labels as int32");
+
+/**
+ * Helper: read-only memory mapping of a whole file. An empty file maps to (nullptr, 0).
+ */
+struct MappedFile {
+    const char* data;
+    size_t size;
+};
+
+static bool mapFile(const std::string& filename, MappedFile& file){
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0){
+        close(fd);
+        return false;
+    }
+    file.size = status.st_size;
+    file.data = nullptr;
+    if (file.size > 0){
+        void* address = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED){
+            close(fd);
+            return false;
+        }
+        madvise(address, file.size, MADV_SEQUENTIAL);
+        file.data = static_cast<const char*>(address);
+    }
+    close(fd);                                                                          // The mapping outlives the descriptor.
+    return true;
+}
+
+static void unmapFile(MappedFile& file){
+    if (file.data) munmap(const_cast<char*>(file.data), file.size);
+    file.data = nullptr;
+}
+
+/**
+ * Helper: checks tour pairs in O(n) with buffers reused across pairs.
+ *
+ * Validity: every label is in [n] and appears once (a "seen" array); paths must have
+ * endpoints 1 and n, in either order.
+ * Disjointness and costs use the primitives of the pair loop of PairEngine (buildTourMask,
+ * tourAvoidsMask and tourCost, see pair_engine.h): the neighbours of every vertex in the first
+ * tour are stored in next/prev arrays, so each edge of the second tour is tested in O(1).
+ */
+class PairChecker {
+public:
+    PairChecker(const bool closed) : closed_(closed) {}
+
+    PairReport check(long long index, const int* tour1, const int n1, const int* tour2, const int n2){
+        PairReport report{index, n1, false, 0, 0, false};
+        if (n1 != n2 || n1 < 2) return report;
+        int n = n1;
+        if (!isValid(tour1, n) || !isValid(tour2, n)) return report;
+
+        report.valid = true;
+        report.cost1 = cost(tour1, n);
+        report.cost2 = cost(tour2, n);
+        report.disjoint = areDisjoint(tour1, tour2, n);
+        return report;
+    }
+
+private:
+    void reserve(const int n){
+        if ((int) seen_.size() < n + 1){
+            seen_.assign(n + 1, 0);
+            next_.assign(n + 1, 0);
+            prev_.assign(n + 1, 0);
+        }
+    }
+
+    bool isValid(const int* tour, const int n){
+        reserve(n);
+        bool valid{true};
+        int i{0};
+        for (; i < n && valid; i++){
+            int v = tour[i];
+            if (v < 1 || v > n || seen_[v]) valid = false;
+            else seen_[v] = 1;
+        }
+        for (int j = 0; j < i; j++){                                                    // Reset only what was marked.
+            int v = tour[j];
+            if (v >= 1 && v <= n) seen_[v] = 0;
+        }
+        if (valid && !closed_){
+            valid = (tour[0] == 1 && tour[n - 1] == n) || (tour[0] == n && tour[n - 1] == 1);
+        }
+        return valid;
+    }
+
+    long long cost(const int* tour, const int n) const{
+        return closed_ ? tourCost(CircleTopology(), tour, n) : tourCost(LineTopology(), tour, n);
+    }
+
+    bool areDisjoint(const int* tour1, const int* tour2, const int n){
+        if (closed_){
+            buildTourMask<CircleTopology>(tour1, n, next_.data(), prev_.data());
+            return tourAvoidsMask<CircleTopology>(tour2, n, next_.data(), prev_.data());
+        }
+        buildTourMask<LineTopology>(tour1, n, next_.data(), prev_.data());
+        return tourAvoidsMask<LineTopology>(tour2, n, next_.data(), prev_.data());
+    }
+
+    const bool closed_;
+    std::vector<char> seen_;
+    std::vector<int> next_;
+    std::vector<int> prev_;
+};
+
+/**
+ * Helper: adds a pair report to the summary and forwards it to the callback.
+ */
+static void record(const PairReport& report, const PairCallback& callback, StreamSummary& summary){
+    summary.pairs++;
+    if (!report.valid) summary.invalid++;
+    else if (report.disjoint){
+        summary.disjoint++;
+        long long total = report.cost1 + report.cost2;
+        if (summary.minTotalCost < 0 || total < summary.minTotalCost) summary.minTotalCost = total;
+    }
+    if (callback) callback(report);
+}
+
+/**
+ * Helper: parses the line [position, lineEnd) of a mapped text file into tour, with a
+ * hand-written unsigned integer scanner. Comment lines give an empty tour; any character
+ * other than digits and blanks makes the line malformed.
+ * @return true if the line is well-formed.
+ */
+static bool parseTourLine(const char* position, const char* lineEnd, std::vector<int>& tour){
+    tour.clear();
+    if (position < lineEnd && *position == '#') return true;
+    for (const char* c = position; c < lineEnd; ){
+        if (*c == ' ' || *c == '\t' || *c == '\r'){
+            c++;
+        }
+        else if (*c >= '0' && *c <= '9'){
+            long long value{0};
+            for (; c < lineEnd && *c >= '0' && *c <= '9'; c++){
+                if (value <= INT32_MAX) value = value * 10 + (*c - '0');
+            }
+            tour.push_back(value > INT32_MAX ? 0 : (int) value);                         // Out-of-range labels fail validation.
+        }
+        else return false;
+    }
+    return true;
+}
+
+/**
+ * Implementation note:
+ * The mapped text is parsed in place (see parseTourLine).
+ * The two tours of the current pair live in buffers that are reused across pairs.
+ */
+bool streamTourPairsText(const std::string& filename, const std::string& topology,
+                         const PairCallback& callback, StreamSummary& summary){
+    assert(topology == "line" || topology == "circle");
+    summary = {0, 0, 0, -1};
+
+    MappedFile file;
+    if (!mapFile(filename, file)) return false;
+
+    PairChecker checker(topology == "circle");
+    std::vector<int> tours[2];
+    int pending{0};
+    bool wellFormed{true};
+    const char* position = file.data;
+    const char* end = file.data + file.size;
+    while (position < end && wellFormed){
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        if (!lineEnd) lineEnd = end;
+
+        std::vector<int>& tour = tours[pending];
+        wellFormed = parseTourLine(position, lineEnd, tour);
+        if (wellFormed && !tour.empty()){
+            if (++pending == 2){
+                record(checker.check(summary.pairs, tours[0].data(), tours[0].size(), tours[1].data(), tours[1].size()),
+                       callback, summary);
+                pending = 0;
+            }
+        }
+        position = lineEnd + 1;
+    }
+    unmapFile(file);
+
+    return wellFormed && pending == 0;
+}
+
+bool readTourPoolText(const std::string& filename, std::vector<std::vector<int>>& tours){
+    tours.clear();
+    MappedFile file;
+    if (!mapFile(filename, file)) return false;
+
+    std::vector<int> tour;
+    bool wellFormed{true};
+    const char* position = file.data;
+    const char* end = file.data + file.size;
+    while (position < end && wellFormed){
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        if (!lineEnd) lineEnd = end;
+        wellFormed = parseTourLine(position, lineEnd, tour);
+        if (wellFormed && !tour.empty()) tours.push_back(tour);
+        position = lineEnd + 1;
+    }
+    unmapFile(file);
+
+    return wellFormed;
+}
+
+/**
+ * Implementation note:
+ * Tours are checked directly in the mapped memory, without copying.
+ * The payload must be a whole number of pairs; n = 0 (written for no pairs) allows no payload.
+ */
+bool streamTourPairsBinary(const std::string& filename, const std::string& topology,
+                           const PairCallback& callback, StreamSummary& summary){
+    assert(topology == "line" || topology == "circle");
+    summary = {0, 0, 0, -1};
+
+    MappedFile file;
+    if (!mapFile(filename, file)) return false;
+
+    const size_t headerSize = 4 + sizeof(uint32_t);
+    uint32_t n{0};
+    bool wellFormed = file.size >= headerSize && std::memcmp(file.data, "PODT", 4) == 0;
+    if (wellFormed){
+        std::memcpy(&n, file.data + 4, sizeof(n));
+        size_t pairSize = 2 * (size_t) n * sizeof(int32_t);
+        wellFormed = (n == 0) ? file.size == headerSize : n >= 2 && (file.size - headerSize) % pairSize == 0;
+    }
+    if (wellFormed && n > 0){
+        PairChecker checker(topology == "circle");
+        const int* labels = reinterpret_cast<const int*>(file.data + headerSize);
+        size_t pairs = (file.size - headerSize) / (2 * (size_t) n * sizeof(int32_t));
+        for (size_t k = 0; k < pairs; k++){
+            const int* tour1 = labels + 2 * k * n;
+            record(checker.check(k, tour1, n, tour1 + n, n), callback, summary);
+        }
+    }
+    unmapFile(file);
+
+    return wellFormed;
+}
+
+bool writeTourPairsText(const std::string& filename, const std::vector<std::vector<int>>& pairs){
+    assert(pairs.size() % 2 == 0);
+    std::ofstream out(filename, std::ios::trunc);
+    if (!out) return false;
+
+    for (const std::vector<int>& tour : pairs){
+        for (int i = 0; i < (int) tour.size(); i++) out << (i > 0 ? " " : "") << tour.at(i);
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool writeTourPairsBinary(const std::string& filename, const std::vector<std::vector<int>>& pairs){
+    assert(pairs.size() % 2 == 0);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    uint32_t n = pairs.empty() ? 0 : pairs.at(0).size();
+    out.write("PODT", 4);
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    for (const std::vector<int>& tour : pairs){
+        assert(tour.size() == n);
+        out.write(reinterpret_cast<const char*>(tour.data()), n * sizeof(int32_t));
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file incremental_sweep.cpp
+ * @brief Implementation of the incremental sweeps over n.
+ *
+ * Each function declared in incremental_sweep.h is implemented here.
+ * Comments focus on the pruning argument that allows dropping tours between levels.
+ */
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+#include <cassert>
+#include <bound.h>
+#include <hamiltonian_paths.h>
+#include <hamiltonian_cycles.h>
+#include <pair_engine.h>
+#include <result_cache.h>
+#include <incremental_sweep.h>
+
+/**
+ * Implementation note:
+ * Levels l = 0, ..., nMax - nMin correspond to n = nMin + l. Tours of level l + 1 are built
+ * from the (surviving) tours of level l by extendCyclesByInsertion / extendPathsByInsertion.
+ *
+ * Pruning: inserting a vertex never decreases the cost of a tour. On the circle, growing n
+ * can only increase the distance between existing labels, and by the triangle inequality
+ * the two new edges cost at least as much as the edge they replace. On the line, the child
+ * costs at least one more than its parent (see extendPathsByInsertion). Hence a tour of
+ * cost c at level l only has descendants of cost >= c + growth * (l' - l) at level l'.
+ * At level l', a tour can only be part of a pair within the bound if its cost is at most
+ * tourLimit[l'] = maxAdmissibleCost - (minimum tour cost at that n). A tour is therefore kept
+ * only if c <= reach[l] = max over l' >= l of tourLimit[l'] - growth * (l' - l).
+ *
+ * The pair search of a level runs on a PairEngine over the surviving tours (ListedTopology),
+ * in list order. Tours above tourLimit need no filtering there: they cannot be part of a pair
+ * within maxCost, which the engine prunes.
+ *
+ * Cached levels skip the pair search, and generation stops after the last uncached level.
+ */
+static std::vector<QueryResult> sweep(const std::string& cacheFile, const int nMin, const int nMax,
+                                      const std::vector<Bound>* bounds, const bool closed){
+    assert(nMax >= nMin);
+    assert(nMin >= (closed ? 3 : 2));
+    const int levels = nMax - nMin + 1;
+    assert(bounds == nullptr || (int) bounds->size() == levels);
+
+    const std::string topology = closed ? "circle" : "line";
+    const std::string mode = bounds ? "within_bound" : "exists";
+    const bool requireOddDepth = closed && bounds;
+    const int growth = closed ? 0 : 1;
+
+    // Per-level cost thresholds (unbounded in "exists" mode)
+    std::vector<long long> tourLimit(levels, LLONG_MAX);
+    std::vector<long long> maxCost(levels, LLONG_MAX);
+    std::vector<long long> reach(levels, LLONG_MAX);
+    if (bounds){
+        for (int l = 0; l < levels; l++){
+            int n = nMin + l;
+            int minTourCost = closed ? n : n - 1;
+            maxCost.at(l) = bounds->at(l).maxAdmissibleCost();
+            tourLimit.at(l) = maxCost.at(l) - minTourCost;
+        }
+        for (int l = levels - 1; l >= 0; l--){
+            reach.at(l) = tourLimit.at(l);
+            if (l + 1 < levels) reach.at(l) = std::max(reach.at(l), reach.at(l + 1) - growth);
+        }
+    }
+
+    // Answer as many levels as possible from the cache
+    std::vector<QueryResult> results(levels);
+    std::vector<QueryKey> keys;
+    std::vector<bool> cached(levels);
+    int lastUncached = -1;
+    for (int l = 0; l < levels; l++){
+        keys.push_back({topology, nMin + l, mode, bounds ? bounds->at(l) : Bound(0), requireOddDepth});
+        cached.at(l) = lookupCachedResult(cacheFile, keys.at(l), results.at(l));
+        if (!cached.at(l)) lastUncached = l;
+    }
+
+    std::vector<std::vector<int>> tours;
+    std::vector<int> costs;
+    for (int l = 0; l <= lastUncached; l++){
+        auto start = std::chrono::steady_clock::now();
+
+        // Generate the tours of this level, from scratch only for the first one
+        if (l == 0) tours = closed ? enumerateCycles(nMin) : enumeratePaths(nMin);
+        else if (closed) tours = extendCyclesByInsertion(tours);
+        else {
+            std::vector<int> extendedCosts;
+            tours = extendPathsByInsertion(tours, costs, extendedCosts);
+            costs.swap(extendedCosts);
+        }
+        if (closed || l == 0){                                                          // Circle costs depend on n.
+            costs.resize(tours.size());
+            for (int i = 0; i < (int) tours.size(); i++){
+                costs.at(i) = closed ? computeCostCycle(tours.at(i)) : computeCostPath(tours.at(i));
+            }
+        }
+
+        // Drop tours that are too expensive for this and every later level
+        int kept{0};
+        for (int i = 0; i < (int) tours.size(); i++){
+            if (costs.at(i) > reach.at(l)) continue;
+            if (kept != i){
+                tours.at(kept).swap(tours.at(i));
+                costs.at(kept) = costs.at(i);
+            }
+            kept++;
+        }
+        tours.resize(kept);
+        costs.resize(kept);
+
+        if (cached.at(l)) continue;
+
+        QueryResult& result = results.at(l);
+        const int n = nMin + l;
+        result.exists = closed ? PairEngine<ListedTopology<CircleTopology>>(n, requireOddDepth, maxCost.at(l), {&tours})
+                                     .findFirst(result.witness1, result.witness2)
+                               : PairEngine<ListedTopology<LineTopology>>(n, false, maxCost.at(l), {&tours})
+                                     .findFirst(result.witness1, result.witness2);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        storeCachedResult(cacheFile, keys.at(l), result);
+    }
+
+    return results;
+}
+
+std::vector<QueryResult> sweepDisjointPaths(const std::string& cacheFile, const int nMin, const int nMax){
+    return sweep(cacheFile, nMin, nMax, nullptr, false);
+}
+
+std::vector<QueryResult> sweepDisjointPathsWithinBound(const std::string& cacheFile, const int nMin, const int nMax,
+                                                       const std::vector<Bound>& bounds){
+    return sweep(cacheFile, nMin, nMax, &bounds, false);
+}
+
+std::vector<QueryResult> sweepDisjointCycles(const std::string& cacheFile, const int nMin, const int nMax){
+    return sweep(cacheFile, nMin, nMax, nullptr, true);
+}
+
+std::vector<QueryResult> sweepDisjointCyclesWithinBound(const std::string& cacheFile, const int nMin, const int nMax,
+                                                        const std::vector<Bound>& bounds){
+    return sweep(cacheFile, nMin, nMax, &bounds, true);
+}
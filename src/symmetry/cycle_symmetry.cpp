@@ -0,0 +1,134 @@
+/**
+ * @file cycle_symmetry.cpp
+ * @brief Implementation of the orderly enumeration of cycle pairs up to dihedral symmetry.
+ *
+ * Each function declared in cycle_symmetry.h is implemented here.
+ * Comments focus on the canonical form of a pair and the orbit-size bookkeeping.
+ */
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include <cassert>
+#include <bound.h>
+#include <hamiltonian_cycles.h>
+#include <pair_engine.h>
+#include <lehmer_codes.h>
+#include <cycle_symmetry.h>
+
+/**
+ * Implementation note:
+ * Vertices are relabelled through 0-based positions on the circle: v -> v + shift or
+ * v -> shift - v (mod n). The image is then rewritten in canonical form.
+ */
+std::vector<int> transformCycle(const std::vector<int>& cycle, const int shift, const bool reflect){
+    int n = cycle.size();
+    std::vector<int> image(n);
+    for (int i = 0; i < n; i++){
+        int position = cycle.at(i) - 1;
+        int mapped = reflect ? (shift - position + n) % n : (position + shift) % n;
+        image.at(i) = mapped + 1;
+    }
+    return canonicalCycle(image);
+}
+
+/**
+ * Implementation note:
+ * Cycles are indexed in lexicographic order, which is the order produced by enumerateCycles
+ * and coincides with Lehmer rank order. For a group element g (g = reflect * n + shift),
+ * images[i * 2n + g] is the index of g(T_i), computed once for all cycles and elements.
+ *
+ * Canonical pair: the key of an unordered pair {T_a, T_b} (a < b) is the lexicographically
+ * smallest (min, max) of the image indices {g(T_a), g(T_b)} over all g. Each orbit has a
+ * unique key (i, j), and i is necessarily the smallest index of its own cycle orbit. So the
+ * search takes T_i over cycle orbit representatives, T_j over larger indices whose orbit
+ * minimum is not below i, and keeps the pair only if no g yields a smaller key.
+ *
+ * Orbit size: the orbit of {T_i, T_j} has 2n / s pairs, where s counts the g mapping the
+ * pair onto itself (in either order). Each member is hit by exactly s group elements, so
+ * with a per-member filter (odd depth, which for even n is not invariant under D_n), the
+ * number of members passing it is (number of g whose image passes) / s.
+ *
+ * Costs and disjointness are invariant, so they are tested on the representative only, by the
+ * row step of a PairEngine over all cycles (forEachDisjointInRow), whose cheap filter skips the
+ * partners of a smaller orbit and those over the cost limit before the disjointness test.
+ */
+static PairOrbitCount enumeratePairOrbits(const int n, const long long maxCost, const bool requireOddDepth,
+                                          const bool stopAtFirst,
+                                          std::vector<int>& witness1, std::vector<int>& witness2){
+    assert(n >= 3);
+    const PairEngine<CircleTopology> engine(n, false, maxCost);
+    const int m = engine.size();
+    const int groupSize = 2 * n;
+    std::vector<uint64_t> ranks(m);
+    for (int i = 0; i < m; i++) ranks.at(i) = encodeLehmer(engine.tour(i));
+
+    std::vector<bool> oddDepth(m);
+    std::vector<int> images((size_t) m * groupSize);
+    std::vector<int> orbitMin(m);
+    for (int i = 0; i < m; i++){
+        const std::vector<int> cycle = engine.tour(i);
+        oddDepth.at(i) = isOddDepthCycle(cycle);
+        orbitMin.at(i) = i;
+        for (int g = 0; g < groupSize; g++){
+            uint64_t rank = encodeLehmer(transformCycle(cycle, g % n, g >= n));
+            int image = std::lower_bound(ranks.begin(), ranks.end(), rank) - ranks.begin();
+            images.at((size_t) i * groupSize + g) = image;
+            orbitMin.at(i) = std::min(orbitMin.at(i), image);
+        }
+    }
+
+    const long long tourLimit = (maxCost == LLONG_MAX) ? LLONG_MAX : maxCost - n;          // Every cycle costs at least n.
+    PairOrbitCount counts{0, 0};
+    for (int i = 0; i < m; i++){
+        if (orbitMin.at(i) != i || engine.cost(i) > tourLimit) continue;
+        const int* imagesI = &images.at((size_t) i * groupSize);
+        auto keep = [&](const int j){ return orbitMin.at(j) >= i && engine.cost(i) + engine.cost(j) <= maxCost; };
+        auto visit = [&](const int j){
+            const int* imagesJ = &images.at((size_t) j * groupSize);
+            bool canonical{true};
+            int stabilizer{0};
+            int passing{0};
+            int passingElement{-1};
+            for (int g = 0; g < groupSize && canonical; g++){
+                int low = std::min(imagesI[g], imagesJ[g]);
+                int high = std::max(imagesI[g], imagesJ[g]);
+                if (low < i || (low == i && high < j)) canonical = false;
+                if (low == i && high == j) stabilizer++;
+                if (!requireOddDepth || (oddDepth.at(imagesI[g]) && oddDepth.at(imagesJ[g]))){
+                    passing++;
+                    passingElement = g;
+                }
+            }
+            if (!canonical || passing == 0) return true;
+
+            counts.orbits++;
+            counts.pairs += passing / stabilizer;
+            if (!stopAtFirst) return true;
+            witness1 = engine.tour(imagesI[passingElement]);
+            witness2 = engine.tour(imagesJ[passingElement]);
+            return false;
+        };
+        if (engine.forEachDisjointInRow(i, i + 1, m, keep, visit) < m) return counts;
+    }
+    return counts;
+}
+
+PairOrbitCount countDisjointCyclePairOrbits(const int n){
+    std::vector<int> witness1, witness2;
+    return enumeratePairOrbits(n, LLONG_MAX, false, false, witness1, witness2);
+}
+
+PairOrbitCount countDisjointCyclePairOrbitsWithinBound(const int n, const Bound& bound){
+    std::vector<int> witness1, witness2;
+    return enumeratePairOrbits(n, bound.maxAdmissibleCost(), true, false, witness1, witness2);
+}
+
+bool findDisjointCyclesUpToSymmetry(const int n, std::vector<int>& witness1, std::vector<int>& witness2){
+    return enumeratePairOrbits(n, LLONG_MAX, false, true, witness1, witness2).orbits > 0;
+}
+
+bool findDisjointCyclesWithinBoundUpToSymmetry(const int n, const Bound& bound,
+                                               std::vector<int>& witness1, std::vector<int>& witness2){
+    return enumeratePairOrbits(n, bound.maxAdmissibleCost(), true, true, witness1, witness2).orbits > 0;
+}
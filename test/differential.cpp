@@ -0,0 +1,566 @@
+/**
+ * @file differential.cpp
+ * @brief Differential correctness oracle for the optimized engines.
+ *
+ * The simple functions of hamiltonian_paths.cpp and hamiltonian_cycles.cpp are the reference:
+ * plain double loops over the enumeration with areDisjoint* and computeCost*, which use none of
+ * the engines. Every other engine (pair engine, sweeps, symmetry reduction, inclusion-exclusion
+ * counting, anytime search, certificates, heuristics, session and query server, linear-time
+ * disjointness tests, tour stream checker) is run on
+ *   - every query for n <= maxN: exists, within_bound (16n/5 and 4n style bounds), count, min;
+ *   - the same instances as distance matrices (lineDistanceMatrix, circleDistanceMatrix), for the
+ *     matrix searches, and for the directed searches against arc-disjoint reference pairs;
+ *   - the all-endpoints table, against the reference (s, t)-path searches;
+ *   - the cost histograms, against the costs of the enumerated tours;
+ *   - random tour pairs, compared property by property (disjointness, cost).
+ * Each mismatch is printed with a reproducer: the query itself (queries are run in increasing
+ * n, so the first one reported per engine is the smallest), or for random pairs, a pair shrunk
+ * by deleting vertices as long as the mismatch persists.
+ *
+ * Usage: differential [--max-n N] [--random K] [--seed S]
+ * The program succeeds only if no mismatch is found.
+ */
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <random>
+#include <climits>
+#include <cstdio>
+#include <functional>
+#include <algorithm>
+#include <hamiltonian_paths.h>
+#include <hamiltonian_cycles.h>
+#include <bound.h>
+#include <incremental_sweep.h>
+#include <cycle_symmetry.h>
+#include <anytime_search.h>
+#include <certificate.h>
+#include <constructions.h>
+#include <local_search.h>
+#include <annealing.h>
+#include <tour_stream.h>
+#include <pair_counting.h>
+#include <pair_engine.h>
+#include <thread_pool.h>
+#include <distance_matrix.h>
+#include <endpoint_paths.h>
+#include <cost_histogram.h>
+#include <session.h>
+#include <query_server.h>
+
+// Scratch file for engines that work on files.
+static const std::string scratchFile = "differential_scratch.tmp";
+
+static long long mismatches{0};
+
+/**
+ * @brief Records and prints a mismatch between the reference and an engine.
+ */
+void reportMismatch(const std::string& query, const std::string& engine, const std::string& expected,
+                    const std::string& actual){
+    mismatches++;
+    std::cout << "MISMATCH " << query << ": reference " << expected << ", " << engine << " " << actual << "\n";
+}
+
+void compare(const std::string& query, const std::string& engine, const bool expected, const bool actual){
+    if (expected != actual) reportMismatch(query, engine, expected ? "true" : "false", actual ? "true" : "false");
+}
+
+void compare(const std::string& query, const std::string& engine, const long long expected, const long long actual){
+    if (expected != actual) reportMismatch(query, engine, std::to_string(expected), std::to_string(actual));
+}
+
+std::string tourString(const std::vector<int>& tour){
+    std::ostringstream out;
+    for (int i = 0; i < (int) tour.size(); i++) out << (i > 0 ? " " : "") << tour.at(i);
+    return out.str();
+}
+
+/**
+ * @brief Reference minimum total cost of a disjoint pair among the given tours, -1 if none.
+ * Uses only the reference functions; pairs that cannot beat the best so far are skipped.
+ * @param directed Compare the tours arc by arc (areArcDisjoint*) instead of edge by edge.
+ */
+long long referenceMinCost(const std::vector<std::vector<int>>& tours, const bool closed, const bool directed){
+    std::vector<int> costs;
+    for (const std::vector<int>& tour : tours) costs.push_back(closed ? computeCostCycle(tour) : computeCostPath(tour));
+
+    long long best{LLONG_MAX};
+    for (int i = 0; i < (int) tours.size(); i++){
+        for (int j = i + 1; j < (int) tours.size(); j++){
+            if (costs.at(i) + costs.at(j) >= best) continue;
+            bool disjoint = directed ? (closed ? areArcDisjointCycles(tours.at(i), tours.at(j)) : areArcDisjointPaths(tours.at(i), tours.at(j)))
+                                     : (closed ? areDisjointCycles(tours.at(i), tours.at(j)) : areDisjointPaths(tours.at(i), tours.at(j)));
+            if (disjoint) best = costs.at(i) + costs.at(j);
+        }
+    }
+    return best == LLONG_MAX ? -1 : best;
+}
+
+/**
+ * @brief Reference minimum total cost of a disjoint pair of tours of [n] (odd-depth cycles if
+ *        oddDepth), -1 if none.
+ */
+long long referenceMinCost(const bool closed, const int n, const bool oddDepth){
+    std::vector<std::vector<int>> tours = closed ? enumerateCycles(n) : enumeratePaths(n);
+    if (oddDepth){
+        tours.erase(std::remove_if(tours.begin(), tours.end(),
+                                   [](const std::vector<int>& cycle){ return !isOddDepthCycle(cycle); }),
+                    tours.end());
+    }
+    return referenceMinCost(tours, closed, false);
+}
+
+/**
+ * @brief Witness pair in the format of the query server ("-" for none).
+ */
+std::string serverTour(const std::vector<int>& tour){
+    if (tour.empty()) return "-";
+    std::string text = tourString(tour);
+    std::replace(text.begin(), text.end(), ' ', ',');
+    return text;
+}
+
+/**
+ * @brief Session and query server: answer and witness pair of an exists or within_bound query,
+ *        which must be those of the reference.
+ */
+void compareSession(Session& session, const std::string& query, const QueryKey& key, const std::string& request,
+                    const bool expected, const std::vector<int>& expected1, const std::vector<int>& expected2){
+    QueryResult result = session.query(key);
+    compare(query, "session", expected, result.exists);
+    if (result.exists && expected && (result.witness1 != expected1 || result.witness2 != expected2)){
+        reportMismatch(query, "session witness", tourString(expected1) + " | " + tourString(expected2),
+                       tourString(result.witness1) + " | " + tourString(result.witness2));
+    }
+    const std::string answer = answerRequest(session, request);
+    const std::string prefix = "ok exists=" + std::to_string(expected) + " witness1=" + serverTour(expected ? expected1 : std::vector<int>())
+                               + " witness2=" + serverTour(expected ? expected2 : std::vector<int>()) + " ";
+    if (answer.compare(0, prefix.size(), prefix) != 0) reportMismatch(query, "server", prefix + "...", answer);
+}
+
+/**
+ * @brief Query server: answer of a count or min request, which must start with the expected text.
+ */
+void compareServer(Session& session, const std::string& query, const std::string& request, const std::string& expected){
+    const std::string answer = answerRequest(session, request);
+    if (answer.compare(0, expected.size(), expected) != 0) reportMismatch(query, "server", expected + "...", answer);
+}
+
+/**
+ * @brief Pair engine: first disjoint pair within a cost limit (odd-depth cycles if depthFilter),
+ *        which must be the reference's first pair, in the order of the plain double loop.
+ */
+bool engineFindsFirst(const std::string& query, const bool closed, const int n, const bool depthFilter, const long long maxCost,
+                      const bool expected, const std::vector<int>& expected1, const std::vector<int>& expected2){
+    std::vector<int> witness1, witness2;
+    bool found = closed ? PairEngine<CircleTopology>(n, depthFilter, maxCost).findFirst(witness1, witness2)
+                        : PairEngine<LineTopology>(n, false, maxCost).findFirst(witness1, witness2);
+    if (found && expected && (witness1 != expected1 || witness2 != expected2)){
+        reportMismatch(query, "pair engine witness", tourString(expected1) + " | " + tourString(expected2),
+                       tourString(witness1) + " | " + tourString(witness2));
+    }
+    return found;
+}
+
+/**
+ * @brief Runs the anytime search to completion and returns its best cost (-1 if none).
+ */
+long long anytimeMinCost(const bool closed, const int n, const bool requireOddDepth){
+    AnytimeSearch search = closed ? startAnytimeCycleSearch(n, requireOddDepth) : startAnytimePathSearch(n);
+    continueAnytimeSearch(search, {0, 0});
+    return search.bestCost;
+}
+
+/**
+ * @brief Certificate engine: a certificate is written (and checks out) iff there is no pair.
+ */
+bool certificateSaysExists(const std::string& query, const std::string& topology, const int n,
+                           const bool requireOddDepth, const Bound& bound){
+    bool written = writeInfeasibilityCertificate(scratchFile, topology, n, requireOddDepth, bound);
+    if (written){
+        CertificateReport report = checkInfeasibilityCertificate(scratchFile);
+        if (!report.valid) reportMismatch(query, "certificate checker", "valid", "invalid: " + report.error);
+    }
+    return !written;
+}
+
+/**
+ * @brief Compares every engine on the exists and within_bound queries for n in [nMin, maxN].
+ */
+void checkExistenceQueries(Session& session, const bool closed, const int nMin, const int maxN){
+    const std::string topology = closed ? "circle" : "line";
+    std::vector<int> witness1, witness2;
+
+    std::vector<QueryResult> sweep = closed ? sweepDisjointCycles("", nMin, maxN) : sweepDisjointPaths("", nMin, maxN);
+    for (int n = nMin; n <= maxN; n++){
+        const std::string query = "exists " + topology + " n=" + std::to_string(n);
+        bool expected = closed ? findDisjointCycles(n, witness1, witness2) : findDisjointPaths(n, witness1, witness2);
+        compare(query, "pair engine", expected, engineFindsFirst(query, closed, n, false, LLONG_MAX, expected, witness1, witness2));
+        compare(query, "sweep", expected, sweep.at(n - nMin).exists);
+        compare(query, "anytime", expected, anytimeMinCost(closed, n, false) >= 0);
+        compare(query, "certificate", expected, certificateSaysExists(query, topology, n, false, Bound(n * n + 1)));
+        compareSession(session, query, {topology, n, "exists", Bound(0), false}, "exists " + topology + " " + std::to_string(n),
+                       expected, witness1, witness2);
+        std::vector<int> symmetric1, symmetric2;
+        if (closed) compare(query, "symmetry", expected, findDisjointCyclesUpToSymmetry(n, symmetric1, symmetric2));
+    }
+
+    // Bounds 16(n - 1)/5 and 4(n - 1) on the line, 16n/5 and 4n on the circle
+    for (int variant = 0; variant < 2; variant++){
+        std::vector<Bound> bounds;
+        for (int n = nMin; n <= maxN; n++){
+            int length = closed ? n : n - 1;
+            bounds.push_back(variant == 0 ? Bound(16 * length, 5) : Bound(4 * length));
+        }
+        std::vector<QueryResult> boundedSweep = closed ? sweepDisjointCyclesWithinBound("", nMin, maxN, bounds)
+                                                       : sweepDisjointPathsWithinBound("", nMin, maxN, bounds);
+        for (int n = nMin; n <= maxN; n++){
+            const Bound& bound = bounds.at(n - nMin);
+            const std::string query = "within_bound " + topology + " n=" + std::to_string(n) + " bound=" + bound.toString();
+            bool expected = closed ? findDisjointCyclesWithinBound(n, bound, witness1, witness2)
+                                   : findDisjointPathsWithinBound(n, bound, witness1, witness2);
+            compare(query, "pair engine", expected,
+                    engineFindsFirst(query, closed, n, closed, bound.maxAdmissibleCost(), expected, witness1, witness2));
+            compare(query, "sweep", expected, boundedSweep.at(n - nMin).exists);
+            long long best = anytimeMinCost(closed, n, closed);
+            compare(query, "anytime", expected, best >= 0 && bound.admits(best));
+            compare(query, "certificate", expected, certificateSaysExists(query, topology, n, closed, bound));
+            compareSession(session, query, {topology, n, "within_bound", bound, closed},
+                           "within_bound " + topology + " " + std::to_string(n) + " " + bound.toString(), expected, witness1, witness2);
+            if (closed){
+                std::vector<int> symmetric1, symmetric2;
+                compare(query, "symmetry", expected, findDisjointCyclesWithinBoundUpToSymmetry(n, bound, symmetric1, symmetric2));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compares the pair engine and the symmetry-reduced counters with the reference counters.
+ */
+void checkCountQueries(Session& session, const int maxN){
+    ThreadPool pool(2);
+    for (int n = 3; n <= maxN; n++){
+        std::string query = "count circle n=" + std::to_string(n);
+        long long expected = countDisjointCycles(n);
+        PairEngine<CircleTopology> engine(n, false, LLONG_MAX);
+        compare(query, "pair engine", expected, engine.count(1));
+        compare(query, "pair engine (pool)", expected, engine.count(pool));
+        compare(query, "symmetry", expected, countDisjointCyclePairOrbits(n).pairs);
+        compare(query, "inclusion-exclusion", expected, (long long) countDisjointCyclesInclusionExclusion(n));
+        compare(query, "session", expected, session.countPairs({"circle", n, "exists", Bound(0), false}));
+        compareServer(session, query, "count circle " + std::to_string(n), "ok count=" + std::to_string(expected));
+
+        Bound bound(16 * n, 5);
+        query = "count_within_bound circle n=" + std::to_string(n) + " bound=" + bound.toString();
+        expected = countDisjointCyclesWithinBound(n, bound);
+        compare(query, "pair engine", expected, PairEngine<CircleTopology>(n, true, bound.maxAdmissibleCost()).count(1));
+        compare(query, "symmetry", expected, countDisjointCyclePairOrbitsWithinBound(n, bound).pairs);
+        compare(query, "session", expected, session.countPairs({"circle", n, "within_bound", bound, true}));
+        compareServer(session, query, "count circle " + std::to_string(n) + " " + bound.toString(), "ok count=" + std::to_string(expected));
+    }
+}
+
+/**
+ * @brief Compares the minimum cost engines; heuristics must return valid pairs and never beat it.
+ */
+void checkMinQueries(Session& session, const bool closed, const int nMin, const int maxN){
+    const std::string topology = closed ? "circle" : "line";
+    AnnealingOptions options{2, 5, 1000, 0.3, 3.0, 1};
+    for (int n = nMin; n <= maxN; n++){
+        const std::string query = "min " + topology + " n=" + std::to_string(n);
+        long long expected = referenceMinCost(closed, n, closed);
+        compare(query, "anytime", expected, anytimeMinCost(closed, n, closed));
+        std::vector<int> witness1, witness2;
+        compare(query, "pair engine", expected, closed ? PairEngine<CircleTopology>(n, true, LLONG_MAX).findMinimum(witness1, witness2)
+                                                       : PairEngine<LineTopology>(n, false, LLONG_MAX).findMinimum(witness1, witness2));
+        compare(query, "session", expected, session.minimumCost(topology, n, closed, witness1, witness2));
+        if (n < (closed ? 8 : 6)) continue;
+
+        std::vector<int> tour1, tour2;
+        for (int engine = 0; engine < 2; engine++){
+            std::string name = engine == 0 ? "local search" : "annealing";
+            long long cost = (engine == 0) ? (closed ? heuristicDisjointCycles(n, 10, n, true, tour1, tour2)
+                                                     : heuristicDisjointPaths(n, 10, n, tour1, tour2))
+                                           : (closed ? annealDisjointCycles(n, options, true, tour1, tour2)
+                                                     : annealDisjointPaths(n, options, tour1, tour2));
+            bool valid = closed ? areDisjointCycles(tour1, tour2) && isOddDepthCycle(tour1) && isOddDepthCycle(tour2)
+                                : areDisjointPaths(tour1, tour2);
+            long long actual = closed ? computeCostCycle(tour1) + computeCostCycle(tour2)
+                                      : computeCostPath(tour1) + computeCostPath(tour2);
+            if (!valid) reportMismatch(query, name, "valid pair", "invalid pair " + tourString(tour1) + " | " + tourString(tour2));
+            compare(query, name + " reported cost", actual, cost);
+            if (cost < expected) reportMismatch(query, name, ">= " + std::to_string(expected), std::to_string(cost));
+        }
+    }
+}
+
+/**
+ * @brief Compares the matrix searches on the line and circle distance matrices with the
+ *        reference (no depth filter), and the directed searches on the same symmetric matrices
+ *        with the reference arc-disjoint pairs (directed cycles only for n <= maxDirectedN).
+ *        The server's min request (no depth filter either) is checked on the way.
+ */
+void checkMatrixQueries(Session& session, const bool closed, const int nMin, const int maxN, const int maxDirectedN){
+    const std::string topology = closed ? "circle" : "line";
+    std::vector<int> witness1, witness2;
+    for (int n = nMin; n <= maxN; n++){
+        const DistanceMatrix matrix = closed ? circleDistanceMatrix(n) : lineDistanceMatrix(n);
+        const int length = closed ? n : n - 1;
+        const Bound bound(16 * length, 5);
+
+        std::string query = "matrix " + topology + " n=" + std::to_string(n);
+        bool expected = closed ? findDisjointCycles(n, witness1, witness2) : findDisjointPaths(n, witness1, witness2);
+        compare(query + " exists", "matrix search", expected, findDisjointToursInMatrix(matrix, closed, Bound(BOUND_MAX), witness1, witness2));
+        long long expectedMin = referenceMinCost(closed, n, false);
+        compare(query + " min", "matrix search", expectedMin, minDisjointToursInMatrix(matrix, closed, witness1, witness2));
+        compare(query + " within_bound " + bound.toString(), "matrix search", expectedMin >= 0 && bound.admits(expectedMin),
+                findDisjointToursInMatrix(matrix, closed, bound, witness1, witness2));
+        compareServer(session, query + " min", "min " + topology + " " + std::to_string(n), "ok cost=" + std::to_string(expectedMin) + " ");
+
+        if (closed && n > maxDirectedN) continue;
+        query = "directed " + query;
+        expectedMin = referenceMinCost(closed ? enumerateDirectedCycles(n) : enumeratePaths(n), closed, true);
+        compare(query + " min", "directed search", expectedMin, minArcDisjointToursInMatrix(matrix, closed, witness1, witness2));
+        compare(query + " exists", "directed search", expectedMin >= 0,
+                findArcDisjointToursInMatrix(matrix, closed, Bound(BOUND_MAX), witness1, witness2));
+        compare(query + " within_bound " + bound.toString(), "directed search", expectedMin >= 0 && bound.admits(expectedMin),
+                findArcDisjointToursInMatrix(matrix, closed, bound, witness1, witness2));
+    }
+}
+
+/**
+ * @brief Compares the all-endpoints table with the reference: entry [1][n] with the (1, n)-path
+ *        minimum, and for n <= maxPairN every entry with the minimum over the (s, t)-paths.
+ */
+void checkEndpointTables(const int nMin, const int maxN, const int maxPairN){
+    std::vector<int> witness1, witness2;
+    for (int n = nMin; n <= maxN; n++){
+        std::vector<std::vector<long long>> table = minDisjointPathCostsForAllEndpoints(n, 2);
+        const std::string query = "endpoints n=" + std::to_string(n);
+        compare(query + " s=1 t=" + std::to_string(n), "endpoint table", referenceMinCost(false, n, false), table.at(1).at(n));
+        if (n > maxPairN) continue;
+        for (int s = 1; s <= n; s++){
+            for (int t = s + 1; t <= n; t++){
+                const std::string pair = query + " s=" + std::to_string(s) + " t=" + std::to_string(t);
+                long long expected = referenceMinCost(enumeratePathsBetween(n, s, t), false, false);
+                compare(pair, "endpoint table", expected, table.at(s).at(t));
+                compare(pair + " (reversed)", "endpoint table", expected, table.at(t).at(s));
+                compare(pair + " exists", "endpoint table", findDisjointPathsBetween(n, s, t, witness1, witness2), table.at(s).at(t) >= 0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compares the cost histograms with the costs of the enumerated tours, entry by entry,
+ *        and the tour counts below a bound read from them.
+ */
+void checkHistograms(const bool closed, const int nMin, const int maxN){
+    const std::string topology = closed ? "circle" : "line";
+    for (int n = nMin; n <= maxN; n++){
+        const std::string query = "histogram " + topology + " n=" + std::to_string(n);
+        std::vector<unsigned long long> expected;
+        for (const std::vector<int>& tour : closed ? enumerateCycles(n) : enumeratePaths(n)){
+            const int cost = closed ? computeCostCycle(tour) : computeCostPath(tour);
+            if ((int) expected.size() <= cost) expected.resize(cost + 1, 0);
+            expected.at(cost)++;
+        }
+        const std::vector<unsigned long long> histogram = closed ? cycleCostHistogram(n) : pathCostHistogram(n);
+        compare(query + " length", "histogram", (long long) expected.size(), (long long) histogram.size());
+        long long expectedTotal{0}, total{0};
+        for (int cost = 0; cost < (int) std::max(expected.size(), histogram.size()); cost++){
+            long long count = cost < (int) histogram.size() ? histogram.at(cost) : 0;
+            long long expectedCount = cost < (int) expected.size() ? expected.at(cost) : 0;
+            compare(query + " cost=" + std::to_string(cost), "histogram", expectedCount, count);
+            expectedTotal += expectedCount;
+            total += count;
+        }
+        compare(query + " total", "histogram", expectedTotal, total);
+
+        const Bound bound(16 * (closed ? n : n - 1), 5);
+        long long expectedWithin{0};
+        for (int cost = 0; cost < (int) expected.size(); cost++) expectedWithin += bound.admits(cost) ? expected.at(cost) : 0;
+        compare(query + " within_bound " + bound.toString(), "histogram", expectedWithin, (long long) countToursWithinBound(histogram, bound));
+    }
+}
+
+/**
+ * @brief A property of a tour pair computed by an engine and by the reference, as text.
+ */
+struct PairProperty {
+    std::string name;
+    std::function<std::string(bool, const std::vector<int>&, const std::vector<int>&)> reference;
+    std::function<std::string(bool, const std::vector<int>&, const std::vector<int>&)> engine;
+};
+
+std::string referenceDisjoint(const bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+    return (closed ? areDisjointCycles(tour1, tour2) : areDisjointPaths(tour1, tour2)) ? "disjoint" : "not disjoint";
+}
+
+std::string referenceCost(const bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+    return "cost " + std::to_string(closed ? computeCostCycle(tour1) + computeCostCycle(tour2)
+                                           : computeCostPath(tour1) + computeCostPath(tour2));
+}
+
+std::string streamReport(const bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2, const bool cost){
+    std::string result{"no report"};
+    StreamSummary summary;
+    writeTourPairsText(scratchFile, {tour1, tour2});
+    streamTourPairsText(scratchFile, closed ? "circle" : "line", [&](const PairReport& report){
+        if (!report.valid) result = "invalid";
+        else if (cost) result = "cost " + std::to_string(report.cost1 + report.cost2);
+        else result = report.disjoint ? "disjoint" : "not disjoint";
+    }, summary);
+    return result;
+}
+
+const std::vector<PairProperty> pairProperties{
+    {"linear disjointness", referenceDisjoint,
+     [](bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+         return (closed ? areDisjointCyclesLinear(tour1, tour2) : areDisjointPathsLinear(tour1, tour2)) ? "disjoint" : "not disjoint";
+     }},
+    {"stream disjointness", referenceDisjoint,
+     [](bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+         return streamReport(closed, tour1, tour2, false);
+     }},
+    {"stream cost", referenceCost,
+     [](bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+         return streamReport(closed, tour1, tour2, true);
+     }},
+    {"dihedral disjointness", referenceDisjoint,
+     [](bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+         if (!closed) return referenceDisjoint(closed, tour1, tour2);
+         return referenceDisjoint(closed, transformCycle(tour1, 1, true), transformCycle(tour2, 1, true));
+     }},
+    {"dihedral cost", referenceCost,
+     [](bool closed, const std::vector<int>& tour1, const std::vector<int>& tour2){
+         if (!closed) return referenceCost(closed, tour1, tour2);
+         return referenceCost(closed, transformCycle(tour1, 1, true), transformCycle(tour2, 1, true));
+     }},
+};
+
+/**
+ * @brief Deletes vertex v from a tour and relabels the larger vertices (cycles are rewritten
+ *        in canonical form).
+ */
+std::vector<int> deleteVertex(const bool closed, const std::vector<int>& tour, const int v){
+    std::vector<int> smaller;
+    for (int u : tour){
+        if (u != v) smaller.push_back(u > v ? u - 1 : u);
+    }
+    return closed ? canonicalCycle(smaller) : smaller;
+}
+
+/**
+ * @brief Greedily deletes vertices while the engine still disagrees with the reference.
+ */
+void minimizePair(const PairProperty& engine, const bool closed, std::vector<int>& tour1, std::vector<int>& tour2){
+    auto fails = [&](const std::vector<int>& a, const std::vector<int>& b){
+        return engine.reference(closed, a, b) != engine.engine(closed, a, b);
+    };
+    bool shrunk{true};
+    while (shrunk && (int) tour1.size() > 3){
+        shrunk = false;
+        int n = tour1.size();
+        for (int v = closed ? 1 : 2; v <= (closed ? n : n - 1) && !shrunk; v++){
+            std::vector<int> smaller1 = deleteVertex(closed, tour1, v);
+            std::vector<int> smaller2 = deleteVertex(closed, tour2, v);
+            if (fails(smaller1, smaller2)){
+                tour1.swap(smaller1);
+                tour2.swap(smaller2);
+                shrunk = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Random tour with the conventions of the topology (paths from 1 to n, canonical cycles).
+ */
+std::vector<int> randomTour(const bool closed, const int n, std::mt19937& rng){
+    std::vector<int> tour(n);
+    for (int i = 0; i < n; i++) tour.at(i) = i + 1;
+    std::shuffle(tour.begin() + 1, tour.end() - (closed ? 0 : 1), rng);
+    return closed ? canonicalCycle(tour) : tour;
+}
+
+/**
+ * @brief Compares the pair engines on random pairs. Half of the pairs are a constructed
+ *        disjoint pair with a random transposition, so both outcomes are well represented.
+ */
+void checkRandomPairs(const int count, const unsigned seed){
+    std::mt19937 rng(seed);
+    for (int k = 0; k < count; k++){
+        bool closed = rng() % 2;
+        int n = 4 + rng() % 13;
+        std::vector<int> tour1, tour2;
+        if (n >= 8 && rng() % 2){
+            if (closed) constructDisjointCycles(n, tour1, tour2);
+            else constructDisjointPaths(n, tour1, tour2);
+            int i = 1 + rng() % (n - 2), j = 1 + rng() % (n - 2);
+            std::swap(tour2.at(i), tour2.at(j));
+            if (closed) tour2 = canonicalCycle(tour2);
+        }
+        else {
+            tour1 = randomTour(closed, n, rng);
+            tour2 = randomTour(closed, n, rng);
+        }
+
+        for (const PairProperty& engine : pairProperties){
+            std::string expected = engine.reference(closed, tour1, tour2);
+            std::string actual = engine.engine(closed, tour1, tour2);
+            if (expected == actual) continue;
+
+            std::vector<int> small1 = tour1, small2 = tour2;
+            minimizePair(engine, closed, small1, small2);
+            reportMismatch(std::string("random ") + (closed ? "circle" : "line") + " pair", engine.name, expected, actual);
+            std::cout << "\tminimized (n = " << small1.size() << "): " << tourString(small1) << " | " << tourString(small2)
+                      << " (reference " << engine.reference(closed, small1, small2)
+                      << ", engine " << engine.engine(closed, small1, small2) << ")\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[]){
+    int maxN{9};
+    int randomPairs{2000};
+    unsigned seed{1};
+    for (int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if (arg == "--max-n" && i + 1 < argc) maxN = std::stoi(argv[++i]);
+        else if (arg == "--random" && i + 1 < argc) randomPairs = std::stoi(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc) seed = std::stoul(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--max-n N] [--random K] [--seed S]\n";
+            return 1;
+        }
+    }
+
+    Session session(SessionOptions{2, ""});
+    std::cout << "Existence queries:\n";
+    checkExistenceQueries(session, false, 3, maxN);
+    checkExistenceQueries(session, true, 3, maxN);
+    std::cout << "Count queries:\n";
+    checkCountQueries(session, maxN);
+    std::cout << "Min queries:\n";
+    checkMinQueries(session, false, 3, maxN);
+    checkMinQueries(session, true, 3, maxN);
+    std::cout << "Distance matrices:\n";
+    checkMatrixQueries(session, false, 3, maxN, maxN);
+    checkMatrixQueries(session, true, 3, maxN, std::min(maxN, 8));
+    std::cout << "Endpoint tables:\n";
+    checkEndpointTables(2, maxN, std::min(maxN, 8));
+    std::cout << "Cost histograms:\n";
+    checkHistograms(false, 2, maxN);
+    checkHistograms(true, 3, maxN);
+    std::cout << "Random pairs:\n";
+    checkRandomPairs(randomPairs, seed);
+    std::remove(scratchFile.c_str());
+
+    std::cout << mismatches << " mismatches.\n";
+    return mismatches == 0 ? 0 : 1;
+}
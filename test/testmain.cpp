@@ -11,9 +11,44 @@
  */
 
 #include <iostream>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <iterator>
+#include <memory>
 #include <cassert>
 #include <hamiltonian_paths.h>
+#include <endpoint_paths.h>
 #include <hamiltonian_cycles.h>
+#include <bound.h>
+#include <lehmer_codes.h>
+#include <result_cache.h>
+#include <incremental_sweep.h>
+#include <cycle_symmetry.h>
+#include <tour_stream.h>
+#include <constructions.h>
+#include <local_search.h>
+#include <annealing.h>
+#include <anytime_search.h>
+#include <certificate.h>
+#include <pair_engine.h>
+#include <distance_matrix.h>
+#include <cost_histogram.h>
+#include <pair_counting.h>
+#include <tour_arena.h>
+#include <huge_pages.h>
+#include <numa_placement.h>
+#include <thread_pool.h>
+#include <session.h>
+#include <query_server.h>
+#include <tour_overlap.h>
+#include <thread>
 
 /**
  * @brief Tests computeCostPath() on several fixed Hamiltonian paths
@@ -65,14 +100,14 @@ int testArePathsWithinBound(){
     int n = 8;
     std::vector<int> testPath1{1, 2, 3, 4, 5, 6, 7, 8};                 // Cost: 7
     std::vector<int> testPath2{1, 3, 5, 7, 2, 4, 6, 8};                 // Cost: 17
-    assert(!arePathsWithinBound(testPath1, testPath2, 16.0*(n - 1)/5.0));
-    assert(arePathsWithinBound(testPath1, testPath2, 4.0*(n - 1)));
+    assert(!arePathsWithinBound(testPath1, testPath2, Bound(16 * (n - 1), 5)));
+    assert(arePathsWithinBound(testPath1, testPath2, Bound(4 * (n - 1))));
 
     n = 11;
     std::vector<int> testPath3{1, 3, 5, 2, 4, 6, 7, 8, 9, 10, 11};      // Cost: 16
     std::vector<int> testPath4{1, 2, 3, 4, 5, 6, 8, 10, 7, 9, 11};      // Cost: 16
-    assert(!arePathsWithinBound(testPath3, testPath4, 16.0*(n - 1)/5.0));
-    assert(arePathsWithinBound(testPath3, testPath4, 4.0*(n - 1)));
+    assert(!arePathsWithinBound(testPath3, testPath4, Bound(16 * (n - 1), 5)));
+    assert(arePathsWithinBound(testPath3, testPath4, Bound(4 * (n - 1))));
 
     return 0;
 }
@@ -85,13 +120,42 @@ int testAreCyclesWithinBound(){
     int n = 8;
     std::vector<int> testCycle1{1, 3, 4, 5, 6, 7, 8, 2};                    // Cost: 10
     std::vector<int> testCycle2{1, 7, 5, 3, 2, 4, 6, 8};                    // Cost: 14    
-    assert(areCyclesWithinBound(testCycle1, testCycle2, 16.0 * n / 5.0));    // Notice that testCycle2 is an even-depth tour. 
-    assert(areCyclesWithinBound(testCycle1, testCycle2, 4.0 * n));
+    assert(areCyclesWithinBound(testCycle1, testCycle2, Bound(16 * n, 5)));    // Notice that testCycle2 is an even-depth tour. 
+    assert(areCyclesWithinBound(testCycle1, testCycle2, Bound(4 * n)));
 
     std::vector<int> testCycle3{1, 2, 4, 5, 6, 7, 8, 3};                     // Cost: 12
     std::vector<int> testCycle4{1, 7, 5, 2, 3, 4, 6, 8};                     // Cost: 14
-    assert(!areCyclesWithinBound(testCycle3, testCycle4, 16.0*(n - 1)/5.0));
-    assert(areCyclesWithinBound(testCycle3, testCycle4, 4.0*(n - 1)));
+    assert(!areCyclesWithinBound(testCycle3, testCycle4, Bound(16 * (n - 1), 5)));
+    assert(areCyclesWithinBound(testCycle3, testCycle4, Bound(4 * (n - 1))));
+
+    return 0;
+}
+
+/**
+ * @brief Tests the Bound type: normalization, exact strict comparisons,
+ * and integer thresholds for integral and fractional bounds.
+ */
+int testBound(){
+    Bound bound1(16 * 7, 5);                                                // 112/5 = 22.4
+    Bound bound2(-32, -10);                                                 // 16/5
+    Bound bound3(24);                                                       // 24/1
+    Bound bound4(-7, 2);                                                    // -3.5
+
+    assert(bound1.numerator == 112 && bound1.denominator == 5);
+    assert(bound2 == Bound(16, 5));
+    assert(bound2.toString() == "16/5");
+
+    assert(bound1.admits(22) && !bound1.admits(23));
+    assert(bound3.admits(23) && !bound3.admits(24));                        // The bound is strict.
+    assert(bound4.admits(-4) && !bound4.admits(-3));
+
+    assert(bound1.maxAdmissibleCost() == 22);
+    assert(bound3.maxAdmissibleCost() == 23);
+    assert(bound4.maxAdmissibleCost() == -4);
+
+    Bound lowest(-BOUND_MAX), largest(BOUND_MAX, BOUND_MAX - 1);            // The ends of the domain.
+    assert(lowest.maxAdmissibleCost() == -BOUND_MAX - 1 && !lowest.admits(-BOUND_MAX) && lowest.admits(LLONG_MIN));
+    assert(largest.maxAdmissibleCost() == 1 && largest.admits(1) && !largest.admits(LLONG_MAX));
 
     return 0;
 }
@@ -176,6 +240,129 @@ int testAreDisjointCycles(){
     return 0;
 }
 
+/**
+ * @brief Tests areDisjointPathsLinear() against areDisjointPaths() on all pairs
+ * of small paths, and on a large pair.
+ */
+int testAreDisjointPathsLinear(){
+    for (int n = 4; n <= 7; n++){
+        std::vector<std::vector<int>> paths = enumeratePaths(n);
+        for (const std::vector<int>& path1 : paths){
+            for (const std::vector<int>& path2 : paths){
+                assert(areDisjointPathsLinear(path1, path2) == areDisjointPaths(path1, path2));
+            }
+        }
+    }
+
+    // Identity and the odd-then-even path: disjoint for even n >= 6.
+    const int n = 1000000;
+    std::vector<int> path1(n), path2(n);
+    for (int i = 0; i < n; i++){
+        path1.at(i) = i + 1;
+        path2.at(i) = (i < n / 2) ? 2 * i + 1 : 2 * (i - n / 2) + 2;
+    }
+    assert(areDisjointPathsLinear(path1, path2));
+    std::swap(path1.at(1), path1.at(2));                                     // path1 now contains edge (1, 3).
+    assert(!areDisjointPathsLinear(path1, path2));
+
+    return 0;
+}
+
+/**
+ * @brief Tests the path searches with arbitrary endpoints, and the all-endpoints minimum
+ * costs against a brute force over every endpoint pair.
+ */
+int testPathsBetween(){
+    for (int n = 3; n <= 7; n++){
+        assert(enumeratePathsBetween(n, 1, n) == enumeratePaths(n));
+        std::vector<std::vector<long long>> table = minDisjointPathCostsForAllEndpoints(n);
+        for (int s = 1; s <= n; s++){
+            assert(table.at(s).at(s) == -1 && table.at(0).at(s) == -1);
+            for (int t = 1; t <= n; t++){
+                if (s == t) continue;
+                std::vector<std::vector<int>> paths = enumeratePathsBetween(n, s, t);
+                long long expected{-1};
+                for (int i = 0; i < (int) paths.size(); i++){
+                    assert(paths.at(i).front() == s && paths.at(i).back() == t);
+                    for (int j = i + 1; j < (int) paths.size(); j++){
+                        if (!areDisjointPaths(paths.at(i), paths.at(j))) continue;
+                        long long cost = computeCostPath(paths.at(i)) + computeCostPath(paths.at(j));
+                        if (expected < 0 || cost < expected) expected = cost;
+                    }
+                }
+                assert(table.at(s).at(t) == expected);
+
+                std::vector<int> witness1, witness2;
+                assert(findDisjointPathsBetween(n, s, t, witness1, witness2) == (expected >= 0));
+                if (expected < 0) continue;
+                assert(witness1.front() == s && witness1.back() == t && areDisjointPaths(witness1, witness2));
+                assert(!findDisjointPathsBetweenWithinBound(n, s, t, Bound(expected), witness1, witness2));
+                assert(findDisjointPathsBetweenWithinBound(n, s, t, Bound(expected + 1), witness1, witness2));
+                assert(computeCostPath(witness1) + computeCostPath(witness2) == expected);
+            }
+        }
+    }
+    assert(minDisjointPathCostsForAllEndpoints(6).at(1).at(6) == 16);
+    assert(minDisjointPathCostsForAllEndpoints(8, 1) == minDisjointPathCostsForAllEndpoints(8, 3));
+    assert(minDisjointPathCostsForAllEndpoints(7).at(7).at(1) == 20);
+
+    return 0;
+}
+
+/**
+ * @brief Tests depthParityChange() against isOddDepthCycle() on all 2-opt moves of all cycles
+ * for small n, including the even n where edges of length n/2 at vertex 1 matter.
+ */
+int testDepthParityChange(){
+    for (int n = 5; n <= 8; n++){
+        for (const std::vector<int>& cycle : enumerateCycles(n)){
+            bool before = isOddDepthCycle(cycle);
+            for (int i = 0; i < n; i++){
+                for (int j = i + 2; j < n; j++){
+                    if (i == 0 && j == n - 1) continue;
+                    std::vector<int> moved = cycle;
+                    std::reverse(moved.begin() + i + 1, moved.begin() + j + 1);
+                    const int removed[4]{cycle.at(i), cycle.at(i + 1), cycle.at(j), cycle.at((j + 1) % n)};
+                    const int added[4]{cycle.at(i), cycle.at(j), cycle.at(i + 1), cycle.at((j + 1) % n)};
+                    int change = depthParityChange(n, removed, added, 2, cycle.at(1), cycle.at(n - 1));
+                    assert(change == (before != isOddDepthCycle(canonicalCycle(moved))));
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests areDisjointCyclesLinear() against areDisjointCycles() on all pairs
+ * of small cycles, on non-canonical rotations, and on a large pair.
+ */
+int testAreDisjointCyclesLinear(){
+    for (int n = 4; n <= 7; n++){
+        std::vector<std::vector<int>> cycles = enumerateCycles(n);
+        for (const std::vector<int>& cycle1 : cycles){
+            for (const std::vector<int>& cycle2 : cycles){
+                assert(areDisjointCyclesLinear(cycle1, cycle2) == areDisjointCycles(cycle1, cycle2));
+            }
+        }
+    }
+    assert(areDisjointCyclesLinear({4, 5, 6, 7, 8, 2, 1, 3}, {2, 4, 6, 8, 1, 7, 5, 3}));
+
+    // Identity and the stride-2 cycle: disjoint for odd n >= 5.
+    const int n = 1000001;
+    std::vector<int> cycle1(n), cycle2(n);
+    for (int i = 0; i < n; i++){
+        cycle1.at(i) = i + 1;
+        cycle2.at(i) = (2 * (long long) i) % n + 1;
+    }
+    assert(areDisjointCyclesLinear(cycle1, cycle2));
+    std::swap(cycle1.at(1), cycle1.at(2));                                   // cycle1 now contains edge (1, 3).
+    assert(!areDisjointCyclesLinear(cycle1, cycle2));
+
+    return 0;
+}
+
 /**
  * @brief Tests isOddDepthCycle() on cycles that are even,
  * odd, or ambiguous-depth.
@@ -194,11 +381,1326 @@ int testIsOddDepthCycle(){
     return 0;
 }
 
+/**
+ * @brief Tests encodeLehmer() and encodeLehmerBatch() on permutations
+ * with known ranks.
+ */
+int testEncodeLehmer(){
+    std::vector<int> testTour1{1, 2, 3, 4};                                 // First permutation: rank 0
+    std::vector<int> testTour2{4, 3, 2, 1};                                 // Last permutation: rank 4! - 1 = 23
+    std::vector<int> testTour3{1, 3, 2, 5, 4};                              // Digits (0, 1, 0, 1, 0): rank 6 + 1 = 7
+    std::vector<int> testTour4{20, 19, 18, 17, 16, 15, 14, 13, 12, 11,
+                               10, 9, 8, 7, 6, 5, 4, 3, 2, 1};              // Rank 20! - 1
+
+    assert(encodeLehmer(testTour1) == 0);
+    assert(encodeLehmer(testTour2) == 23);
+    assert(encodeLehmer(testTour3) == 7);
+    assert(encodeLehmer(testTour4) == 2432902008176639999ULL);
+
+    std::vector<uint64_t> ranks = encodeLehmerBatch({testTour1, testTour2});
+    assert(ranks.size() == 2 && ranks.at(0) == 0 && ranks.at(1) == 23);
+
+    return 0;
+}
+
+/**
+ * @brief Tests decodeLehmer() and decodeLehmerBatch() by round-tripping
+ * every permutation of a small set.
+ */
+int testDecodeLehmer(){
+    std::vector<int> testTour{1, 3, 2, 5, 4};
+    assert(decodeLehmer(7, 5) == testTour);
+    assert(decodeLehmer(0, 1) == std::vector<int>{1});
+
+    std::vector<uint64_t> ranks(120);
+    for(int rank = 0; rank < 120; rank++) ranks.at(rank) = rank;
+    std::vector<std::vector<int>> tours = decodeLehmerBatch(ranks, 5);
+    assert(encodeLehmerBatch(tours) == ranks);
+
+    return 0;
+}
+
+/**
+ * @brief Tests writeTourStore() and readTourStore() by round-tripping
+ * a set of tours through a temporary file.
+ */
+int testTourStore(){
+    std::vector<std::vector<int>> testTours{{1, 3, 4, 5, 6, 7, 8, 2},
+                                            {1, 7, 5, 3, 2, 4, 6, 8},
+                                            {1, 2, 4, 5, 6, 7, 8, 3}};
+    const std::string filename = "testmain_tour_store.bin";
+    assert(writeTourStore(filename, 8, testTours));
+
+    int n{0};
+    std::vector<std::vector<int>> readTours;
+    assert(readTourStore(filename, n, readTours));
+    assert(n == 8);
+    assert(readTours == testTours);
+
+    // Corrupt files are rejected: a count beyond the file, a truncated payload, a rank >= n!.
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    const uint64_t hugeCount = UINT64_MAX / 4;
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(&hugeCount), sizeof(hugeCount));
+    file.close();
+    assert(!readTourStore(filename, n, readTours));
+    assert(writeTourStore(filename, 8, testTours));
+    {
+        std::ofstream append(filename, std::ios::binary | std::ios::app);
+        append.put(0);
+    }
+    assert(!readTourStore(filename, n, readTours));
+    assert(writeTourStore(filename, 8, testTours));
+    file.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+    const uint64_t badRank = 40320;
+    file.seekp(16);
+    file.write(reinterpret_cast<const char*>(&badRank), sizeof(badRank));
+    file.close();
+    assert(!readTourStore(filename, n, readTours));
+
+    // Tours of another size, or that are not permutations, are refused before the file is touched.
+    assert(writeTourStore(filename, 8, testTours));
+    assert(!writeTourStore(filename, 8, {{1, 2, 3, 4, 5, 6, 7}}));
+    assert(!writeTourStore(filename, 8, {{1, 2, 3, 4, 5, 6, 7, 7}}));
+    assert(!writeTourStore(filename, 21, {}));
+    assert(readTourStore(filename, n, readTours) && readTours == testTours);
+
+    std::remove(filename.c_str());
+    assert(!readTourStore(filename, n, readTours));
+
+    return 0;
+}
+
+/**
+ * @brief Tests queryKeyString() distinguishes queries that differ in any field
+ * and ignores the bound in "exists" mode.
+ */
+int testQueryKeyString(){
+    QueryKey key1{"circle", 8, "within_bound", Bound(16 * 8, 5), true};
+    QueryKey key2{"circle", 8, "within_bound", Bound(4 * 8), true};
+    QueryKey key3{"line", 8, "within_bound", Bound(16 * 8, 5), false};
+    QueryKey key4{"line", 8, "exists", Bound(1), false};
+    QueryKey key5{"line", 8, "exists", Bound(2), false};
+
+    assert(queryKeyString(key1) == queryKeyString(key1));
+    assert(queryKeyString(key1) != queryKeyString(key2));
+    assert(queryKeyString(key1) != queryKeyString(key3));
+    assert(queryKeyString(key3) != queryKeyString(key4));
+    assert(queryKeyString(key4) == queryKeyString(key5));
+
+    return 0;
+}
+
+/**
+ * @brief Tests storeCachedResult(), lookupCachedResult() and runCachedQuery()
+ * on a temporary cache file.
+ */
+int testResultCache(){
+    const std::string filename = "testmain_result_cache.txt";
+    std::remove(filename.c_str());
+
+    QueryKey key{"line", 6, "exists", Bound(0), false};
+    QueryResult result;
+    assert(!lookupCachedResult(filename, key, result));
+
+    // A miss runs the search and stores its answer and witness.
+    QueryResult computed = runCachedQuery(filename, key);
+    assert(computed.exists);
+    assert(areDisjointPaths(computed.witness1, computed.witness2));
+    assert(lookupCachedResult(filename, key, result));
+    assert(result.exists && result.witness1 == computed.witness1 && result.witness2 == computed.witness2);
+
+    // Cached negative answers carry no witness.
+    QueryKey negativeKey{"circle", 4, "exists", Bound(0), false};
+    assert(!runCachedQuery(filename, negativeKey).exists);
+    assert(lookupCachedResult(filename, negativeKey, result));
+    assert(!result.exists && result.witness1.empty());
+
+    // The last entry for a key wins.
+    QueryResult overridden{false, {}, {}, 0.0};
+    assert(storeCachedResult(filename, key, overridden));
+    assert(lookupCachedResult(filename, key, result) && !result.exists);
+
+    // Corrupt entries are skipped instead of throwing; the last well-formed one still wins.
+    {
+        std::ofstream corrupt(filename, std::ios::app);
+        const std::string keyString = queryKeyString(key);
+        corrupt << keyString << "\t1\tnan?\t-\t-\n" << keyString << "\t1\t0.5\t12x\t-\n"
+                << keyString << "\t1\t0.5\t99999999999999999999999\t-\n" << keyString << "\t1\t0.5\t720\t-\n"
+                << keyString << "\t2\t0.5\t-\t-\n";
+    }
+    assert(lookupCachedResult(filename, key, result) && !result.exists);
+    assert(runCachedQuery(filename, key).exists == result.exists);
+
+    std::remove(filename.c_str());
+
+    return 0;
+}
+
+/**
+ * @brief Tests extendPathsByInsertion() against direct enumeration,
+ * including the incrementally updated costs.
+ */
+int testExtendPathsByInsertion(){
+    for (int n = 2; n <= 7; n++){
+        std::vector<std::vector<int>> paths = enumeratePaths(n);
+        std::vector<int> costs;
+        for (const std::vector<int>& path : paths) costs.push_back(computeCostPath(path));
+
+        std::vector<int> extendedCosts;
+        std::vector<std::vector<int>> extended = extendPathsByInsertion(paths, costs, extendedCosts);
+        for (int i = 0; i < (int) extended.size(); i++) assert(extendedCosts.at(i) == computeCostPath(extended.at(i)));
+
+        std::vector<std::vector<int>> expected = enumeratePaths(n + 1);
+        std::sort(extended.begin(), extended.end());
+        assert(extended == expected);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests extendCyclesByInsertion() against direct enumeration.
+ */
+int testExtendCyclesByInsertion(){
+    for (int n = 3; n <= 7; n++){
+        std::vector<std::vector<int>> extended = extendCyclesByInsertion(enumerateCycles(n));
+        std::vector<std::vector<int>> expected = enumerateCycles(n + 1);
+        std::sort(extended.begin(), extended.end());
+        assert(extended == expected);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests the incremental sweeps agree with the per-n searches,
+ * and that their witnesses are valid.
+ */
+int testSweeps(){
+    std::vector<QueryResult> pathResults = sweepDisjointPaths("", 3, 7);
+    std::vector<QueryResult> cycleResults = sweepDisjointCycles("", 3, 7);
+    for (int n = 3; n <= 7; n++){
+        assert(pathResults.at(n - 3).exists == disjointPathsExist(n));
+        assert(cycleResults.at(n - 3).exists == disjointCyclesExist(n));
+    }
+
+    std::vector<Bound> bounds{Bound(16 * 6, 5), Bound(21), Bound(16 * 8, 5), Bound(4 * 8)};     // Mixed tight and loose bounds.
+    std::vector<QueryResult> boundedPathResults = sweepDisjointPathsWithinBound("", 5, 8, bounds);
+    std::vector<QueryResult> boundedCycleResults = sweepDisjointCyclesWithinBound("", 5, 8, bounds);
+    for (int n = 5; n <= 8; n++){
+        const Bound& bound = bounds.at(n - 5);
+        const QueryResult& pathResult = boundedPathResults.at(n - 5);
+        const QueryResult& cycleResult = boundedCycleResults.at(n - 5);
+
+        assert(pathResult.exists == disjointPathsExistWithinBound(n, bound));
+        assert(cycleResult.exists == disjointCyclesExistWithinBound(n, bound));
+        if (pathResult.exists){
+            assert(areDisjointPaths(pathResult.witness1, pathResult.witness2));
+            assert(arePathsWithinBound(pathResult.witness1, pathResult.witness2, bound));
+        }
+        if (cycleResult.exists){
+            assert(areDisjointCycles(cycleResult.witness1, cycleResult.witness2));
+            assert(areCyclesWithinBound(cycleResult.witness1, cycleResult.witness2, bound));
+            assert(isOddDepthCycle(cycleResult.witness1) && isOddDepthCycle(cycleResult.witness2));
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests canonicalCycle() and transformCycle() on fixed cycles.
+ */
+int testTransformCycle(){
+    std::vector<int> testCycle{1, 3, 2, 5, 4};
+
+    assert(canonicalCycle({3, 2, 5, 4, 1}) == testCycle);                      // Rotation
+    assert(canonicalCycle({1, 4, 5, 2, 3}) == testCycle);                      // Reversal
+    assert(transformCycle(testCycle, 0, false) == testCycle);                  // Identity
+    assert(transformCycle(testCycle, 1, false) == canonicalCycle({2, 4, 3, 1, 5}));
+    assert(transformCycle(testCycle, 0, true) == canonicalCycle({1, 4, 5, 2, 3}));
+
+    // Symmetries preserve costs and disjointness.
+    std::vector<int> testCycle1{1, 3, 4, 5, 6, 7, 8, 2};
+    std::vector<int> testCycle2{1, 7, 5, 3, 2, 4, 6, 8};
+    for (int g = 0; g < 16; g++){
+        std::vector<int> image1 = transformCycle(testCycle1, g % 8, g >= 8);
+        std::vector<int> image2 = transformCycle(testCycle2, g % 8, g >= 8);
+        assert(computeCostCycle(image1) == computeCostCycle(testCycle1));
+        assert(areDisjointCycles(image1, image2));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests the pair orbit enumeration against the reference counters
+ * and the reference searches.
+ */
+int testPairOrbits(){
+    for (int n = 3; n <= 8; n++){
+        PairOrbitCount counts = countDisjointCyclePairOrbits(n);
+        assert(counts.pairs == countDisjointCycles(n));
+        assert(counts.orbits <= counts.pairs);
+
+        for (const Bound& bound : {Bound(16 * n, 5), Bound(4 * n), Bound(5 * n)}){
+            PairOrbitCount boundedCounts = countDisjointCyclePairOrbitsWithinBound(n, bound);
+            assert(boundedCounts.pairs == countDisjointCyclesWithinBound(n, bound));
+
+            std::vector<int> witness1, witness2;
+            bool found = findDisjointCyclesWithinBoundUpToSymmetry(n, bound, witness1, witness2);
+            assert(found == disjointCyclesExistWithinBound(n, bound));
+            if (found){
+                assert(areDisjointCycles(witness1, witness2) && areCyclesWithinBound(witness1, witness2, bound));
+                assert(isOddDepthCycle(witness1) && isOddDepthCycle(witness2));
+            }
+        }
+
+        std::vector<int> witness1, witness2;
+        assert(findDisjointCyclesUpToSymmetry(n, witness1, witness2) == disjointCyclesExist(n));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests streamTourPairsText() and streamTourPairsBinary() on small pairs
+ * checked against the reference functions, and on a large pair.
+ */
+int testTourStream(){
+    std::vector<std::vector<int>> testCycles{{1, 3, 4, 5, 6, 7, 8, 2}, {1, 7, 5, 3, 2, 4, 6, 8},       // Disjoint
+                                             {1, 2, 4, 5, 6, 7, 8, 3}, {1, 3, 4, 5, 6, 7, 8, 2},       // Not disjoint
+                                             {4, 5, 6, 7, 8, 2, 1, 3}, {2, 4, 6, 8, 1, 7, 5, 3},       // Disjoint, other rotations
+                                             {1, 2, 2, 4, 5, 6, 7, 8}, {1, 3, 4, 5, 6, 7, 8, 2}};      // Invalid
+    const std::string textFile = "testmain_pairs.txt";
+    const std::string binaryFile = "testmain_pairs.bin";
+    assert(writeTourPairsText(textFile, testCycles));
+    assert(writeTourPairsBinary(binaryFile, testCycles));
+
+    for (int format = 0; format < 2; format++){
+        std::vector<PairReport> reports;
+        StreamSummary summary;
+        PairCallback collect = [&reports](const PairReport& report){ reports.push_back(report); };
+        bool ok = (format == 0) ? streamTourPairsText(textFile, "circle", collect, summary)
+                                : streamTourPairsBinary(binaryFile, "circle", collect, summary);
+        assert(ok);
+        assert(summary.pairs == 4 && summary.invalid == 1 && summary.disjoint == 2);
+        assert(summary.minTotalCost == 24);
+        for (int k = 0; k < 3; k++){
+            const std::vector<int>& cycle1 = testCycles.at(2 * k);
+            const std::vector<int>& cycle2 = testCycles.at(2 * k + 1);
+            assert(reports.at(k).valid);
+            assert(reports.at(k).cost1 == computeCostCycle(canonicalCycle(cycle1)));
+            assert(reports.at(k).cost2 == computeCostCycle(canonicalCycle(cycle2)));
+            assert(reports.at(k).disjoint == areDisjointCycles(canonicalCycle(cycle1), canonicalCycle(cycle2)));
+        }
+        assert(!reports.at(3).valid);
+    }
+
+    // Paths must have endpoints 1 and n.
+    StreamSummary summary;
+    assert(streamTourPairsText(textFile, "line", PairCallback(), summary));
+    assert(summary.pairs == 4 && summary.invalid == 4);
+    assert(writeTourPairsText(textFile, {{1, 2, 3, 4, 5, 6}, {1, 3, 5, 2, 4, 6}, {6, 5, 4, 3, 2, 1}, {1, 3, 2, 5, 4, 6}}));
+    assert(streamTourPairsText(textFile, "line", PairCallback(), summary));
+    assert(summary.pairs == 2 && summary.invalid == 0 && summary.disjoint == 1 && summary.minTotalCost == 5 + 11);
+
+    // Large pair: the identity and the stride-2 cycle for odd n are disjoint, with costs n and 2n.
+    const int n = 1000001;
+    std::vector<std::vector<int>> largePair(2, std::vector<int>(n));
+    for (int i = 0; i < n; i++){
+        largePair.at(0).at(i) = i + 1;
+        largePair.at(1).at(i) = (2 * (long long) i) % n + 1;
+    }
+    assert(writeTourPairsBinary(binaryFile, largePair));
+    assert(streamTourPairsBinary(binaryFile, "circle", PairCallback(), summary));
+    assert(summary.pairs == 1 && summary.disjoint == 1 && summary.minTotalCost == 3LL * n);
+
+    // An empty list of pairs round-trips (n = 0, no payload), and a payload with n = 0 is rejected.
+    assert(writeTourPairsBinary(binaryFile, {}));
+    assert(streamTourPairsBinary(binaryFile, "line", PairCallback(), summary) && summary.pairs == 0);
+    {
+        std::ofstream append(binaryFile, std::ios::binary | std::ios::app);
+        append.write("\0\0\0\0", 4);
+    }
+    assert(!streamTourPairsBinary(binaryFile, "line", PairCallback(), summary));
+
+    // Malformed files are rejected.
+    std::ofstream(textFile) << "1 2 3\n1 x 3\n";
+    assert(!streamTourPairsText(textFile, "line", PairCallback(), summary));
+    std::remove(textFile.c_str());
+    std::remove(binaryFile.c_str());
+    assert(!streamTourPairsBinary(binaryFile, "line", PairCallback(), summary));
+
+    return 0;
+}
+
+/**
+ * @brief Tests constructDisjointPaths(), constructDisjointCycles() and writeConstructedWitness():
+ * the pairs are valid and disjoint, match the exact optima for small n and the 16n/5 costs.
+ */
+int testConstructions(){
+    std::vector<int> tour1, tour2;
+
+    // Exact minimum total costs for n = 6, ..., 11 (line) and n = 8, ..., 11 (circle, odd-depth).
+    const std::vector<int> lineOptima{16, 20, 24, 28, 30, 32};
+    const std::vector<int> circleOptima{28, 30, 32, 36};
+    for (int n = 6; n <= 11; n++){
+        constructDisjointPaths(n, tour1, tour2);
+        assert(computeCostPath(tour1) + computeCostPath(tour2) == lineOptima.at(n - 6));
+        if (n >= 8){
+            constructDisjointCycles(n, tour1, tour2);
+            assert(computeCostCycle(tour1) + computeCostCycle(tour2) == circleOptima.at(n - 8));
+        }
+    }
+
+    for (int n = 6; n <= 60; n++){
+        constructDisjointPaths(n, tour1, tour2);
+        assert(tour2.front() == 1 && tour2.back() == n);
+        assert(std::is_permutation(tour1.begin(), tour1.end(), tour2.begin()));
+        assert(areDisjointPathsLinear(tour1, tour2));
+        int lineCost = computeCostPath(tour1) + computeCostPath(tour2);
+        assert(5 * lineCost >= 16 * (n - 1) && 5 * lineCost <= 16 * (n - 1) + 50);
+        if ((n - 1) % 5 == 0) assert(5 * lineCost == 16 * (n - 1));
+
+        constructDisjointCycles(n, tour1, tour2);
+        assert(tour2 == canonicalCycle(tour2));
+        assert(std::is_permutation(tour1.begin(), tour1.end(), tour2.begin()));
+        assert(areDisjointCyclesLinear(tour1, tour2));
+        assert(isOddDepthCycle(tour1) && (n == 7 || isOddDepthCycle(tour2)));
+        int circleCost = computeCostCycle(tour1) + computeCostCycle(tour2);
+        if (n % 5 == 0) assert(5 * circleCost == 16 * n);
+    }
+
+    // Large witnesses round-trip through the stream reader.
+    const std::string witnessFile = "test_witness.tmp";
+    const int n = 1000001;
+    StreamSummary summary;
+    assert(writeConstructedWitness(witnessFile, "line", n, true));
+    assert(streamTourPairsBinary(witnessFile, "line", PairCallback(), summary));
+    assert(summary.pairs == 1 && summary.disjoint == 1 && 5 * summary.minTotalCost == 16LL * (n - 1));
+    assert(writeConstructedWitness(witnessFile, "circle", n, false));
+    assert(streamTourPairsText(witnessFile, "circle", PairCallback(), summary));
+    assert(summary.pairs == 1 && summary.disjoint == 1 && summary.minTotalCost >= 16LL * n / 5);
+    std::remove(witnessFile.c_str());
+
+    return 0;
+}
+
+/**
+ * @brief Tests improveDisjointPaths(), improveDisjointCycles() and the iterated local searches:
+ * the pairs stay valid, disjoint and odd-depth, and never beat the exact optima.
+ */
+int testLocalSearch(){
+    // Line: the identity with the odd-then-even path.
+    std::vector<int> path1{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::vector<int> path2{1, 3, 5, 7, 9, 11, 2, 4, 6, 8, 10, 12};
+    LocalSearchStats stats = improveDisjointPaths(path1, path2);
+    assert(stats.initialCost == 11 + 29 && stats.finalCost < stats.initialCost && stats.moves > 0);
+    assert(stats.finalCost == computeCostPath(path1) + computeCostPath(path2));
+    assert(path1.front() == 1 && path1.back() == 12 && path2.front() == 1 && path2.back() == 12);
+    assert(std::is_permutation(path1.begin(), path1.end(), path2.begin()));
+    assert(areDisjointPathsLinear(path1, path2));
+
+    // Circle: the identity with the stride-2 cycle, with and without the depth constraint.
+    std::vector<int> cycle1{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    std::vector<int> cycle2{1, 3, 5, 7, 9, 11, 2, 4, 6, 8, 10};
+    stats = improveDisjointCycles(cycle1, cycle2, false);
+    assert(stats.initialCost == 11 + 22 && stats.finalCost <= stats.initialCost);
+    assert(stats.finalCost == computeCostCycle(cycle1) + computeCostCycle(cycle2));
+    assert(cycle1 == canonicalCycle(cycle1) && cycle2 == canonicalCycle(cycle2));
+    assert(areDisjointCyclesLinear(cycle1, cycle2));
+
+    std::vector<int> tour1, tour2;
+    constructDisjointCycles(23, tour1, tour2);
+    std::reverse(tour2.begin() + 1, tour2.begin() + 8);                                 // A worse, still odd-depth, start.
+    assert(areDisjointCyclesLinear(tour1, tour2) && isOddDepthCycle(tour2));
+    stats = improveDisjointCycles(tour1, tour2, true);
+    assert(stats.finalCost < stats.initialCost);
+    assert(areDisjointCyclesLinear(tour1, tour2) && isOddDepthCycle(tour1) && isOddDepthCycle(tour2));
+
+    // Iterated local search reaches, and never beats, the exact optima for small n.
+    const std::vector<int> lineOptima{16, 20, 24, 28, 30, 32};
+    const std::vector<int> circleOptima{28, 30, 32, 36};
+    for (int n = 6; n <= 11; n++){
+        assert(heuristicDisjointPaths(n, 30, n, tour1, tour2) == lineOptima.at(n - 6));
+        assert(areDisjointPathsLinear(tour1, tour2));
+        if (n >= 8){
+            assert(heuristicDisjointCycles(n, 30, n, true, tour1, tour2) == circleOptima.at(n - 8));
+            assert(areDisjointCyclesLinear(tour1, tour2) && isOddDepthCycle(tour1) && isOddDepthCycle(tour2));
+        }
+    }
+
+    // Larger n: never worse than the construction.
+    std::vector<int> constructed1, constructed2;
+    constructDisjointCycles(60, constructed1, constructed2);
+    long long cost = heuristicDisjointCycles(60, 20, 1, true, tour1, tour2);
+    assert(cost <= computeCostCycle(constructed1) + computeCostCycle(constructed2));
+    assert(cost == computeCostCycle(tour1) + computeCostCycle(tour2));
+    assert(areDisjointCyclesLinear(tour1, tour2) && isOddDepthCycle(tour1) && isOddDepthCycle(tour2));
+
+    return 0;
+}
+
+/**
+ * @brief Tests annealDisjointPaths() and annealDisjointCycles(): the best pairs are valid,
+ * disjoint and odd-depth, consistent with their reported cost, and never beat the exact optima.
+ */
+int testAnnealing(){
+    AnnealingOptions options{3, 10, 2000, 0.3, 3.0, 7};
+    std::vector<int> tour1, tour2;
+
+    const std::vector<int> lineOptima{16, 20, 24, 28, 30, 32};
+    const std::vector<int> circleOptima{28, 30, 32, 36};
+    for (int n = 8; n <= 11; n++){
+        assert(annealDisjointPaths(n, options, tour1, tour2) == lineOptima.at(n - 6));
+        assert(areDisjointPathsLinear(tour1, tour2));
+        assert(annealDisjointCycles(n, options, true, tour1, tour2) == circleOptima.at(n - 8));
+        assert(areDisjointCyclesLinear(tour1, tour2) && isOddDepthCycle(tour1) && isOddDepthCycle(tour2));
+    }
+
+    const int n = 200;
+    long long cost = annealDisjointPaths(n, options, tour1, tour2);
+    assert(cost == computeCostPath(tour1) + computeCostPath(tour2));
+    assert(tour1.front() == 1 && tour1.back() == n && tour2.front() == 1 && tour2.back() == n);
+    assert(std::is_permutation(tour1.begin(), tour1.end(), tour2.begin()));
+    assert(areDisjointPathsLinear(tour1, tour2));
+
+    cost = annealDisjointCycles(n, options, true, tour1, tour2);
+    assert(cost == computeCostCycle(tour1) + computeCostCycle(tour2));
+    assert(tour1 == canonicalCycle(tour1) && tour2 == canonicalCycle(tour2));
+    assert(areDisjointCyclesLinear(tour1, tour2) && isOddDepthCycle(tour1) && isOddDepthCycle(tour2));
+
+    // Runs are reproducible for a fixed seed, regardless of thread scheduling.
+    std::vector<int> again1, again2;
+    assert(annealDisjointCycles(n, options, true, again1, again2) == cost);
+    assert(again1 == tour1 && again2 == tour2);
+
+    return 0;
+}
+
+/**
+ * @brief Tests the anytime search: complete runs find the exact optima, budgeted runs report
+ * valid bounds and resume to the same answer, and seeds only tighten the upper bound.
+ */
+int testAnytimeSearch(){
+    // Complete runs.
+    AnytimeSearch search = startAnytimePathSearch(7);
+    assert(continueAnytimeSearch(search, {0, 0}));
+    assert(search.complete && search.bestCost == 20 && search.lowerBound == 20);
+    assert(areDisjointPaths(search.witness1, search.witness2));
+    assert(computeCostPath(search.witness1) + computeCostPath(search.witness2) == 20);
+
+    search = startAnytimePathSearch(4);
+    assert(continueAnytimeSearch(search, {0, 0}));
+    assert(search.bestCost == -1 && search.lowerBound == LLONG_MAX);
+
+    // Budgeted runs: the lower bound never decreases and the gap closes on resumption.
+    search = startAnytimeCycleSearch(8, true);
+    const long long nodes = search.nodes;
+    long long lowerBound = search.lowerBound;
+    int calls{0};
+    while (!continueAnytimeSearch(search, {50, 0})){
+        assert(search.lowerBound >= lowerBound && search.lowerBound <= 28);
+        assert(search.bestCost < 0 || search.bestCost >= 28);
+        lowerBound = search.lowerBound;
+        calls++;
+    }
+    assert(calls > 0 && search.nodes > nodes);
+    assert(search.bestCost == 28 && search.lowerBound == 28);
+    assert(isOddDepthCycle(search.witness1) && isOddDepthCycle(search.witness2));
+    assert(areDisjointCycles(search.witness1, search.witness2));
+
+    AnytimeSearch unbudgeted = startAnytimeCycleSearch(8, true);
+    assert(continueAnytimeSearch(unbudgeted, {0, 0}));
+    assert(unbudgeted.bestCost == 28 && unbudgeted.nodes <= search.nodes);
+
+    // Seeding with an optimal pair leaves only the proof of optimality.
+    std::vector<int> tour1, tour2;
+    constructDisjointCycles(9, tour1, tour2);
+    search = startAnytimeCycleSearch(9, true);
+    seedAnytimeSearch(search, tour1, tour2);
+    assert(search.bestCost == 30 && search.lowerBound < 30);
+    assert(!continueAnytimeSearch(search, {1, 0}));
+    assert(search.bestCost == 30 && search.lowerBound <= 30);
+    assert(continueAnytimeSearch(search, {0, 1e9}));
+    assert(search.bestCost == 30 && search.lowerBound == 30 && search.witness1 == tour1);
+
+    return 0;
+}
+
+/**
+ * @brief Tests writeInfeasibilityCertificate() and checkInfeasibilityCertificate(): certificates
+ * exist exactly for the negative claims, check out, and are rejected once tampered with.
+ */
+int testCertificates(){
+    const std::string certificateFile = "test_certificate.tmp";
+
+    // Observation 1 (i) and (ii) for n = 5 and 7, and Observation 4 (ii) for n = 8.
+    assert(writeInfeasibilityCertificate(certificateFile, "line", 5, false, Bound(26)));
+    CertificateReport report = checkInfeasibilityCertificate(certificateFile);
+    assert(report.valid && report.topology == "line" && report.n == 5 && !report.oddDepth);
+    assert(report.tours == 6 && report.pairs == 15 && report.prunedSubtrees == 0);
+
+    assert(writeInfeasibilityCertificate(certificateFile, "line", 7, false, Bound(16 * 6, 5)));
+    report = checkInfeasibilityCertificate(certificateFile);
+    assert(report.valid && report.numerator == 96 && report.denominator == 5 && report.prunedSubtrees > 0);
+
+    assert(writeInfeasibilityCertificate(certificateFile, "circle", 8, true, Bound(16 * 8, 5)));
+    report = checkInfeasibilityCertificate(certificateFile);
+    assert(report.valid && report.topology == "circle" && report.oddDepth && report.pairs > 0);
+
+    // Tampering with a pair refutation or with a pruning decision is detected.
+    std::vector<char> bytes;
+    {
+        std::ifstream in(certificateFile, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::vector<char> tampered = bytes;
+    bool rejected{false};
+    for (char k = 0; k < 8 && !rejected; k++){                                          // Not every edge is shared.
+        tampered.back() = k;
+        std::ofstream(certificateFile, std::ios::binary).write(tampered.data(), tampered.size());
+        rejected = !checkInfeasibilityCertificate(certificateFile).valid;
+    }
+    assert(rejected);
+
+    const size_t treeStart = 4 + 4 + 1 + 1 + 4 + 8 + 8 + 8;
+    tampered = bytes;
+    tampered.at(treeStart) = 1 - tampered.at(treeStart);
+    std::ofstream(certificateFile, std::ios::binary).write(tampered.data(), tampered.size());
+    assert(!checkInfeasibilityCertificate(certificateFile).valid);
+
+    std::ofstream(certificateFile, std::ios::binary).write(bytes.data(), bytes.size() - 1);
+    assert(!checkInfeasibilityCertificate(certificateFile).valid);
+
+    // No certificate for claims that are false.
+    assert(!writeInfeasibilityCertificate(certificateFile, "line", 6, false, Bound(4 * 5)));
+    assert(!writeInfeasibilityCertificate(certificateFile, "circle", 5, false, Bound(26)));
+    std::remove(certificateFile.c_str());
+    assert(!checkInfeasibilityCertificate(certificateFile).valid);
+
+    return 0;
+}
+
+/**
+ * @brief Tests the pair engine against plain double loops over the enumerations,
+ * for both topologies, with and without depth filter and cost limit.
+ */
+template <class Topology>
+void checkPairEngine(const int n, const bool useDepthFilter, const long long maxCost){
+    std::vector<std::vector<int>> tours = Topology::closed ? enumerateCycles(n) : enumeratePaths(n);
+    std::vector<std::vector<int>> visited;
+    Topology::forEachTour(n, [&visited](const std::vector<int>& tour){ visited.push_back(tour); });
+    assert(visited == tours);
+    std::vector<std::vector<int>> kept;
+    for (const std::vector<int>& tour : tours){
+        if (!useDepthFilter || Topology::passesDepthFilter(tour)) kept.push_back(tour);
+    }
+
+    long long expectedCount{0};
+    std::vector<int> expected1, expected2;
+    for (int i = 0; i < (int) kept.size(); i++){
+        for (int j = i + 1; j < (int) kept.size(); j++){
+            const std::vector<int>& a = kept.at(i);
+            const std::vector<int>& b = kept.at(j);
+            long long cost = Topology::closed ? computeCostCycle(a) + computeCostCycle(b) : computeCostPath(a) + computeCostPath(b);
+            bool disjoint = Topology::closed ? areDisjointCycles(a, b) : areDisjointPaths(a, b);
+            if (cost > maxCost || !disjoint) continue;
+            if (expectedCount++ == 0){
+                expected1 = a;
+                expected2 = b;
+            }
+        }
+    }
+
+    PairEngine<Topology> engine(n, useDepthFilter, maxCost);
+    assert(engine.size() == (int) kept.size());
+    assert(engine.count(1) == expectedCount);
+    assert(engine.count(3) == expectedCount);
+    std::vector<int> witness1, witness2;
+    assert(engine.findFirst(witness1, witness2) == (expectedCount > 0));
+    if (expectedCount > 0) assert(witness1 == expected1 && witness2 == expected2);
+}
+
+int testPairEngine(){
+    for (int n = 3; n <= 8; n++){
+        for (long long maxCost : {LLONG_MAX, 16LL * n / 5, 4LL * n}){
+            checkPairEngine<LineTopology>(n, false, maxCost);
+            checkPairEngine<CircleTopology>(n, false, maxCost);
+            checkPairEngine<CircleTopology>(n, true, maxCost);
+        }
+    }
+
+    assert(LineTopology::edgeCost(8, 1, 8) == 7);
+    assert(CircleTopology::edgeCost(8, 1, 8) == 1);
+    assert(CircleTopology::edgeCost(8, 2, 6) == 4);
+
+    return 0;
+}
+
+/**
+ * @brief Tests the distance matrix readers and generators, and the matrix searches against the
+ * line and circle engines.
+ */
+int testDistanceMatrix(){
+    // Line and circle matrices reproduce the specialized metrics.
+    std::vector<int> witness1, witness2;
+    for (int n = 4; n <= 8; n++){
+        DistanceMatrix line = lineDistanceMatrix(n);
+        DistanceMatrix circle = circleDistanceMatrix(n);
+        assert(isValidDistanceMatrix(line) && isValidDistanceMatrix(circle));
+
+        long long lineMin = PairEngine<LineTopology>(n, false, LLONG_MAX).findMinimum(witness1, witness2);
+        assert(minDisjointToursInMatrix(line, false, witness1, witness2) == lineMin);
+        if (lineMin >= 0) assert(areDisjointPaths(witness1, witness2) && computeCostPath(witness1) + computeCostPath(witness2) == lineMin);
+
+        long long circleMin = PairEngine<CircleTopology>(n, false, LLONG_MAX).findMinimum(witness1, witness2);
+        assert(minDisjointToursInMatrix(circle, true, witness1, witness2) == circleMin);
+        if (circleMin >= 0) assert(areDisjointCycles(witness1, witness2) && computeCostCycle(witness1) + computeCostCycle(witness2) == circleMin);
+
+        for (const Bound& bound : {Bound(16 * (n - 1), 5), Bound(4 * n)}){
+            assert(findDisjointToursInMatrix(line, false, bound, witness1, witness2) == disjointPathsExistWithinBound(n, bound));
+        }
+    }
+    assert(minDisjointToursInMatrix(lineDistanceMatrix(6), false, witness1, witness2) == 16);
+    assert(minDisjointToursInMatrix(lineDistanceMatrix(5), false, witness1, witness2) == -1);
+    assert(!findDisjointToursInMatrix(lineDistanceMatrix(6), false, Bound(16), witness1, witness2));
+    assert(findDisjointToursInMatrix(lineDistanceMatrix(6), false, Bound(17), witness1, witness2));
+
+    // Generators.
+    DistanceMatrix grid = gridDistanceMatrix(2, 3, 10);
+    assert(grid.n == 6 && isValidDistanceMatrix(grid));
+    assert(grid.at(1, 2) == 10 && grid.at(1, 3) == 20 && grid.at(1, 5) == 14 && grid.at(1, 6) == 22);
+    DistanceMatrix random = randomPointsDistanceMatrix(7, 100, 1);
+    assert(random.n == 7 && isValidDistanceMatrix(random));
+    assert(minDisjointToursInMatrix(random, true, witness1, witness2) > 0 && areDisjointCycles(witness1, witness2));
+
+    // Plain and TSPLIB files.
+    const std::string matrixFile = "test_distance_matrix.tmp";
+    std::ofstream(matrixFile) << "3\n0 1 2\n1 0 3\n2 3 0\n";
+    DistanceMatrix read;
+    assert(readDistanceMatrix(matrixFile, read) && read.n == 3 && read.at(2, 3) == 3);
+    std::ofstream(matrixFile) << "3\n0 1 2\n1 0 3\n2 4 0\n";
+    assert(!readDistanceMatrix(matrixFile, read));
+    // Headers larger than the file, and weights whose pair costs would overflow, are rejected.
+    std::ofstream(matrixFile) << "2000000000\n0 1\n1 0\n";
+    assert(!readDistanceMatrix(matrixFile, read));
+    std::ofstream(matrixFile) << "3\n0 1 2\n1 0 3\n2 3\n";
+    assert(!readDistanceMatrix(matrixFile, read));
+    std::ofstream(matrixFile) << "3\n0 1 2\n1 0 " << INT_MAX / 6 + 1 << "\n2 " << INT_MAX / 6 + 1 << " 0\n";
+    assert(!readDistanceMatrix(matrixFile, read));
+    std::ofstream(matrixFile) << "3\n0 1 2\n1 0 " << INT_MAX / 6 << "\n2 " << INT_MAX / 6 << " 0\n";
+    assert(readDistanceMatrix(matrixFile, read));
+    assert(minDisjointToursInMatrix(read, false, witness1, witness2) == -1);
+    std::ofstream(matrixFile) << "NAME: huge\nDIMENSION: 1000000000\nEDGE_WEIGHT_TYPE: EXPLICIT\n"
+                              << "EDGE_WEIGHT_FORMAT: FULL_MATRIX\nEDGE_WEIGHT_SECTION\n0 1\n1 0\nEOF\n";
+    assert(!readTsplibInstance(matrixFile, read));
+    std::ofstream(matrixFile) << "NAME: huge\nDIMENSION: 1000000000\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\nEOF\n";
+    assert(!readTsplibInstance(matrixFile, read));
+
+    std::ofstream(matrixFile) << "NAME : grid6\nTYPE : TSP\nDIMENSION : 6\nEDGE_WEIGHT_TYPE : EUC_2D\nNODE_COORD_SECTION\n"
+                              << "1 0 0\n2 10 0\n3 20 0\n4 0 10\n5 10 10\n6 20 10\nEOF\n";
+    assert(readTsplibInstance(matrixFile, read) && read.weights == grid.weights);
+
+    std::ofstream(matrixFile) << "NAME: tiny\nDIMENSION: 4\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: UPPER_ROW\n"
+                              << "EDGE_WEIGHT_SECTION\n1 2 3\n4 5\n6\nEOF\n";
+    assert(readTsplibInstance(matrixFile, read) && read.n == 4);
+    assert(read.at(1, 4) == 3 && read.at(4, 1) == 3 && read.at(2, 3) == 4 && read.at(3, 4) == 6 && read.at(4, 4) == 0);
+
+    std::ofstream(matrixFile) << "NAME: tiny\nDIMENSION: 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: LOWER_DIAG_ROW\n"
+                              << "EDGE_WEIGHT_SECTION\n0 5 0 7 9 0\nEOF\n";
+    assert(readTsplibInstance(matrixFile, read) && read.at(1, 2) == 5 && read.at(3, 1) == 7 && read.at(2, 3) == 9);
+
+    // Unsupported, misspelt or missing formats are rejected rather than read as zeros.
+    for (std::string format : {"EDGE_WEIGHT_FORMAT: UPPER_COL\n", "EDGE_WEIGHT_FORMAT: LOWER_COL\n",
+                               "EDGE_WEIGHT_FORMAT: UPPER_ROWS\n", ""}){
+        std::ofstream(matrixFile) << "NAME: tiny\nDIMENSION: 4\nEDGE_WEIGHT_TYPE: EXPLICIT\n" << format
+                                  << "EDGE_WEIGHT_SECTION\n1 2 3\n4 5\n6\nEOF\n";
+        assert(!readTsplibInstance(matrixFile, read));
+    }
+    std::remove(matrixFile.c_str());
+    assert(!readTsplibInstance(matrixFile, read));
+
+    return 0;
+}
+
+/**
+ * @brief Tests the directed (arc-disjoint) variants against brute force over the directed
+ * enumerations, on symmetric and asymmetric matrices.
+ */
+int testArcDisjointTours(){
+    for (int n = 3; n <= 6; n++){
+        std::vector<std::vector<int>> cycles = enumerateDirectedCycles(n);
+        long long factorial{1};
+        for (int k = 2; k < n; k++) factorial *= k;
+        assert((long long) cycles.size() == factorial);
+        for (const std::vector<int>& cycle : cycles){
+            std::vector<int> reversed(cycle);
+            std::reverse(reversed.begin() + 1, reversed.end());
+            assert(areArcDisjointCycles(cycle, reversed));                     // Opposite orientations share no arc.
+            assert(!areArcDisjointCycles(cycle, cycle));
+        }
+    }
+
+    std::vector<int> witness1, witness2;
+    std::mt19937 rng(7);
+    for (int n = 4; n <= 7; n++){
+        // The cheapest arc-disjoint cycles in the circle are the identity in both directions.
+        assert(minArcDisjointToursInMatrix(circleDistanceMatrix(n), true, witness1, witness2) == 2 * n);
+
+        DistanceMatrix asymmetric{n, std::vector<int>(n * n, 0)};
+        for (int a = 1; a <= n; a++){
+            for (int b = 1; b <= n; b++) asymmetric.weights[(a - 1) * n + (b - 1)] = (a == b) ? 0 : 1 + rng() % 20;
+        }
+        assert(isValidDistanceMatrix(asymmetric, false) && !isValidDistanceMatrix(asymmetric));
+
+        for (bool closed : {false, true}){
+            std::vector<std::vector<int>> tours = closed ? enumerateDirectedCycles(n) : enumeratePaths(n);
+            long long expected{-1};
+            for (int i = 0; i < (int) tours.size(); i++){
+                for (int j = i + 1; j < (int) tours.size(); j++){
+                    const std::vector<int>& a = tours.at(i);
+                    const std::vector<int>& b = tours.at(j);
+                    if (closed ? !areArcDisjointCycles(a, b) : !areArcDisjointPaths(a, b)) continue;
+                    long long cost{0};
+                    for (const std::vector<int>* tour : {&a, &b}){
+                        for (int k = 0; k + 1 < n + (closed ? 1 : 0); k++) cost += asymmetric.at(tour->at(k), tour->at((k + 1) % n));
+                    }
+                    if (expected < 0 || cost < expected) expected = cost;
+                }
+            }
+            assert(minArcDisjointToursInMatrix(asymmetric, closed, witness1, witness2) == expected);
+            assert(findArcDisjointToursInMatrix(asymmetric, closed, Bound(BOUND_MAX), witness1, witness2) == (expected >= 0));
+            if (expected < 0) continue;
+            assert(closed ? areArcDisjointCycles(witness1, witness2) : areArcDisjointPaths(witness1, witness2));
+            assert(!findArcDisjointToursInMatrix(asymmetric, closed, Bound(expected), witness1, witness2));
+            assert(findArcDisjointToursInMatrix(asymmetric, closed, Bound(expected + 1), witness1, witness2));
+        }
+    }
+
+    // Arc-disjoint paths exist where edge-disjoint ones do not (n = 5).
+    assert(minArcDisjointToursInMatrix(lineDistanceMatrix(5), false, witness1, witness2) > 0);
+    assert(minDisjointToursInMatrix(lineDistanceMatrix(5), false, witness1, witness2) == -1);
+
+    // Asymmetric files are only accepted when allowed.
+    const std::string matrixFile = "test_directed_matrix.tmp";
+    std::ofstream(matrixFile) << "3\n0 1 2\n4 0 3\n2 3 0\n";
+    DistanceMatrix read;
+    assert(!readDistanceMatrix(matrixFile, read) && readDistanceMatrix(matrixFile, read, false) && read.at(2, 1) == 4);
+    std::ofstream(matrixFile) << "NAME: a\nTYPE: ATSP\nDIMENSION: 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                              << "EDGE_WEIGHT_SECTION\n0 1 2\n4 0 3\n2 3 0\nEOF\n";
+    assert(readTsplibInstance(matrixFile, read) && read.at(1, 2) == 1 && read.at(2, 1) == 4);
+    std::remove(matrixFile.c_str());
+
+    return 0;
+}
+
+/**
+ * @brief Tests the cost histograms against the enumerations, and their totals for larger n.
+ */
+int testCostHistograms(){
+    for (int n = 2; n <= 9; n++){
+        std::vector<unsigned long long> expected(1, 0);
+        for (const std::vector<int>& path : enumeratePaths(n)){
+            int cost = computeCostPath(path);
+            if (cost >= (int) expected.size()) expected.resize(cost + 1, 0);
+            expected.at(cost)++;
+        }
+        assert(pathCostHistogram(n) == expected);
+
+        unsigned long long cheap{0};
+        for (const std::vector<int>& path : enumeratePaths(n)) cheap += Bound(8 * (n - 1), 5).admits(computeCostPath(path));
+        assert(countToursWithinBound(expected, Bound(8 * (n - 1), 5)) == cheap);
+    }
+    for (int n = 3; n <= 9; n++){
+        std::vector<unsigned long long> expected(1, 0);
+        for (const std::vector<int>& cycle : enumerateCycles(n)){
+            int cost = computeCostCycle(cycle);
+            if (cost >= (int) expected.size()) expected.resize(cost + 1, 0);
+            expected.at(cost)++;
+        }
+        assert(cycleCostHistogram(n) == expected);
+    }
+
+    // Totals are (n - 2)! paths and (n - 1)!/2 cycles; the cheapest tours are the identity.
+    std::vector<unsigned long long> paths = pathCostHistogram(13);
+    std::vector<unsigned long long> cycles = cycleCostHistogram(13);
+    unsigned long long pathTotal{0}, cycleTotal{0};
+    for (unsigned long long count : paths) pathTotal += count;
+    for (unsigned long long count : cycles) cycleTotal += count;
+    assert(pathTotal == 39916800ULL && cycleTotal == 239500800ULL);
+    assert(paths.at(12) == 1 && countToursWithinBound(paths, Bound(12)) == 0);
+    assert(cycles.at(13) == 1 && cycles.at(14) == 0 && countToursWithinBound(cycles, Bound(14)) == 1);
+
+    return 0;
+}
+
+/**
+ * @brief Tests the linear forest counts against all edge subsets of K_n, and the
+ * inclusion-exclusion pair counts against the reference counter.
+ */
+int testInclusionExclusion(){
+    for (int n = 2; n <= 6; n++){
+        std::vector<std::pair<int, int>> edges;
+        for (int a = 0; a < n; a++){
+            for (int b = a + 1; b < n; b++) edges.push_back({a, b});
+        }
+        std::vector<std::vector<long long>> expected(n, std::vector<long long>(n + 1, 0));
+        for (long long subset = 0; subset < (1LL << edges.size()); subset++){
+            // Union-find on the chosen edges: a linear forest has degrees <= 2 and no cycle.
+            std::vector<int> degree(n, 0), root(n), size(n, 1);
+            for (int v = 0; v < n; v++) root.at(v) = v;
+            auto find = [&](int v){ while (root.at(v) != v) v = root.at(v); return v; };
+            bool forest{true};
+            int count{0};
+            for (int e = 0; e < (int) edges.size() && forest; e++){
+                if (!(subset >> e & 1)) continue;
+                auto [a, b] = edges.at(e);
+                int ra = find(a), rb = find(b);
+                forest = ++degree.at(a) <= 2 && ++degree.at(b) <= 2 && ra != rb;
+                root.at(ra) = rb;
+                size.at(rb) += size.at(ra);
+                count++;
+            }
+            if (!forest) continue;
+            int fragments{0};
+            for (int v = 0; v < n; v++) fragments += (find(v) == v && size.at(v) >= 2);
+            expected.at(count).at(fragments)++;
+        }
+        for (int e = 0; e < n; e++){
+            for (int p = 0; p <= n; p++) assert(countLinearForests(n, e, p) == expected.at(e).at(p));
+        }
+    }
+
+    for (int n = 3; n <= 8; n++) assert(countDisjointCyclesInclusionExclusion(n) == countDisjointCycles(n));
+    assert(exactCountToString(countDisjointCyclesInclusionExclusion(9)) == "15654240");
+    assert(exactCountToString(countDisjointCyclesInclusionExclusion(20)) == "200506636535031224564356270080000");
+    assert(countDisjointCyclesInclusionExclusion(30) == -1);                      // Beyond 128 bits.
+    assert(exactCountToString(-1205) == "-1205" && exactCountToString(0) == "0");
+
+    return 0;
+}
+
+/**
+ * @brief Tests the arena: alignment, reuse after a rewind, oversized blocks, per-thread
+ * instances, and that the pair engine gives back everything it takes.
+ */
+int testTourArena(){
+    TourArena arena(1024);
+    TourArena::Mark start = arena.mark();
+    int* first = static_cast<int*>(arena.allocate(10 * sizeof(int), alignof(int)));
+    void* aligned = arena.allocate(3, 64);
+    assert(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    for (int k = 0; k < 10; k++) first[k] = k;
+
+    TourArena::Mark middle = arena.mark();
+    void* large = arena.allocate(100000);                                               // Oversized: a block of its own.
+    assert(large != nullptr && arena.bytesReserved() >= 1024 + 100000);
+    arena.rewind(middle);
+    assert(arena.bytesReserved() == 1024);                                              // The oversized block is freed.
+    for (int k = 0; k < 10; k++) assert(first[k] == k);                                 // Memory below the mark is untouched.
+
+    std::size_t used = arena.bytesInUse();
+    for (int round = 0; round < 3; round++){                                            // Same memory every round.
+        ArenaScope scope(arena);
+        ArenaVector<int> buffer(100, 7, ArenaAllocator<int>(arena));
+        assert(buffer.at(99) == 7 && arena.bytesInUse() > used);
+    }
+    assert(arena.bytesInUse() == used && arena.bytesReserved() == 1024);
+
+    for (int block = 0; block < 5; block++) arena.allocate(1000, alignof(int));         // Spills over several blocks.
+    assert(arena.bytesReserved() >= 5 * 1000);
+    arena.rewind(start);
+    assert(arena.bytesInUse() == 0);
+    arena.reset();
+    assert(arena.bytesInUse() == 0);
+
+    // Every thread has its own arena.
+    TourArena* mine = &threadArena();
+    TourArena* theirs{nullptr};
+    std::thread([&theirs](){ theirs = &threadArena(); }).join();
+    assert(mine != theirs);
+
+    // An engine gives back the arena memory it used, and gives the same results twice in a row.
+    std::size_t before = threadArena().bytesInUse();
+    std::vector<int> witness1, witness2;
+    for (int round = 0; round < 2; round++){
+        PairEngine<CircleTopology> engine(8, false, LLONG_MAX);
+        assert(engine.count(2) == countDisjointCycles(8));
+        assert(engine.findMinimum(witness1, witness2) == PairEngine<CircleTopology>(8, false, LLONG_MAX).findMinimum(witness1, witness2));
+    }
+    assert(threadArena().bytesInUse() == before);
+
+    // Engines own the arena of their tables, so they may be destroyed in any order.
+    std::unique_ptr<PairEngine<CircleTopology>> older(new PairEngine<CircleTopology>(10, false, LLONG_MAX));
+    std::unique_ptr<PairEngine<CircleTopology>> newer(new PairEngine<CircleTopology>(10, false, LLONG_MAX));
+    const std::vector<int> fifth = newer->tour(5), last = newer->tour(newer->size() - 1);
+    older.reset();
+    std::vector<int> scratch(100000, 7);                                                // Would reuse freed memory.
+    assert(newer->tour(5) == fifth && newer->tour(newer->size() - 1) == last);
+    assert(fifth == PairEngine<CircleTopology>(10, false, LLONG_MAX).tour(5));
+    newer.reset();
+    assert(threadArena().bytesInUse() == before);
+
+    return 0;
+}
+
+/**
+ * @brief Tests the huge page policies: every policy gives usable memory, and the statistics
+ * account for every table. Whether huge pages are actually granted depends on the system.
+ */
+int testHugePages(){
+    HugePagePolicy policy;
+    assert(parseHugePagePolicy("transparent", policy) && policy == HugePagePolicy::Transparent);
+    assert(parseHugePagePolicy("explicit", policy) && policy == HugePagePolicy::Explicit);
+    assert(parseHugePagePolicy("off", policy) && policy == HugePagePolicy::Off);
+    assert(!parseHugePagePolicy("always", policy));
+    assert(hugePageSize() >= 4096 && (hugePageSize() & (hugePageSize() - 1)) == 0);
+
+    const HugePagePolicy previous = hugePagePolicy();
+    const std::size_t bytes = 3 * hugePageSize() + 100;
+    for (HugePagePolicy tried : {HugePagePolicy::Off, HugePagePolicy::Transparent, HugePagePolicy::Explicit}){
+        setHugePagePolicy(tried);
+        HugePageStats before = hugePageStats();
+        void* table = allocateLargeTable(bytes);
+        if (tried == HugePagePolicy::Off) assert(table == nullptr);
+        if (table != nullptr){
+            assert(reinterpret_cast<std::uintptr_t>(table) % hugePageSize() == 0);
+            std::fill(static_cast<char*>(table), static_cast<char*>(table) + bytes, 1);
+            HugePageStats live = hugePageStats();                                       // Measured while live...
+            releaseLargeTable(table);
+            HugePageStats released = hugePageStats();                                   // ...and kept after release.
+            assert(released.transparentBytes == live.transparentBytes && released.unmeasuredBytes == before.unmeasuredBytes);
+        }
+        HugePageStats after = hugePageStats();
+        assert(after.tables == before.tables + 1 && after.requestedBytes == before.requestedBytes + bytes);
+        std::size_t backed = (after.explicitBytes - before.explicitBytes) + (after.transparentBytes - before.transparentBytes);
+        assert(backed <= bytes);
+        assert(after.regularBytes - before.regularBytes == (table == nullptr ? bytes : 0));
+    }
+
+    // Only oversized arena requests of a huge page or more go through the policy, and searches are unchanged.
+    setHugePagePolicy(HugePagePolicy::Transparent);
+    HugePageStats before = hugePageStats();
+    {
+        TourArena arena(1024);
+        char* block = static_cast<char*>(arena.allocate(bytes));
+        std::fill(block, block + bytes, 0);
+    }
+    HugePageStats after = hugePageStats();
+    assert(after.tables == before.tables + 1);
+    if (after.regularBytes == before.regularBytes) assert(after.unmeasuredBytes == before.unmeasuredBytes + bytes + alignof(std::max_align_t));
+    {
+        TourArena arena(2 * bytes);
+        char* block = static_cast<char*>(arena.allocate(bytes));
+        std::fill(block, block + bytes, 0);
+    }
+    assert(hugePageStats().tables == after.tables);
+    assert(countDisjointCycles(8) == PairEngine<CircleTopology>(8, false, LLONG_MAX).count(1));
+    assert(hugePageStatsLine(hugePageStats()).find("huge-page backed") != std::string::npos);
+    setHugePagePolicy(previous);
+
+    return 0;
+}
+
+/**
+ * @brief Tests the NUMA helpers, and the placed parallel count on a simulated two-node layout
+ * (both nodes share the CPU the tests run on, so pinning works on any machine).
+ */
+int testNumaPlacement(){
+    assert(parseCpuList("0-3,8,10-11") == std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    assert(parseCpuList("5, 2-2\n") == std::vector<int>({2, 5}));
+    assert(parseCpuList("").empty() && parseCpuList("3-1").empty() && parseCpuList("x").empty());
+
+    NumaTopology detected = detectNumaTopology();
+    assert(detected.nodes() >= 1);
+    for (const std::vector<int>& cpus : detected.cpus) assert(!cpus.empty());
+
+    // Workers follow the CPU counts of the nodes, and cycle over the CPUs of a node.
+    NumaTopology uneven{{{0, 1, 2, 3}, {4, 5}}};
+    std::vector<WorkerPlacement> placements = placeWorkers(uneven, 6);
+    assert(std::count_if(placements.begin(), placements.end(), [](const WorkerPlacement& p){ return p.node == 0; }) == 4);
+    for (const WorkerPlacement& p : placements) assert(std::count(uneven.cpus[p.node].begin(), uneven.cpus[p.node].end(), p.cpu) == 1);
+    placements = placeWorkers(NumaTopology{{{7}}}, 3);
+    for (const WorkerPlacement& p : placements) assert(p.node == 0 && p.cpu == 7);
+
+    // Row i reads the rows i, ..., rows - 1: with 4 rows, worker 0 reads 4 + 2, worker 1 reads 3 + 1.
+    std::vector<WorkerPlacement> two{{0, 0}, {1, 1}};
+    assert(estimateRemoteAccessRatio(4, two, {0, 1}) == 0);
+    assert(std::abs(estimateRemoteAccessRatio(4, two, {0, 0}) - 0.4) < 1e-12);
+    assert(estimateRemoteAccessRatio(4, two, {1, 0}) == 1);
+
+    // Placed counts agree with the plain count, with and without replicas.
+    const int cpu = detected.cpus.front().front();
+    NumaTopology simulated{{{cpu}, {cpu}}};
+    for (int n = 6; n <= 8; n++){
+        PairEngine<CircleTopology> engine(n, true, 4LL * n);
+        const long long expected = engine.count(1);
+        for (bool replicate : {false, true}){
+            ParallelOptions options;
+            options.threads = 4;
+            options.pinThreads = true;
+            options.replicateTables = replicate;
+            options.topology = &simulated;
+            ParallelReport report;
+            assert(engine.count(options, &report) == expected);
+            assert(report.threads == 4 && report.nodes == 2 && report.pinnedThreads == 4);
+            assert(report.replicas == (replicate ? 2 : 0));
+            if (replicate) assert(report.remoteAccessRatio == 0);
+            else assert(report.remoteAccessRatio > 0 && report.remoteAccessRatio < 1);
+            assert(parallelReportLine(report).find("remote") != std::string::npos);
+        }
+    }
+    ParallelOptions single;
+    single.threads = 2;
+    ParallelReport report;
+    assert(PairEngine<LineTopology>(7, false, LLONG_MAX).count(single, &report) == PairEngine<LineTopology>(7, false, LLONG_MAX).count(1));
+    assert(report.replicas == 0 && report.pinnedThreads == 0 && report.remoteAccessRatio == -1);
+    assert(parallelReportLine(report).find("unknown") != std::string::npos);
+
+    // Replicas need pinned workers.
+    single.replicateTables = true;
+    single.topology = &simulated;
+    assert(PairEngine<LineTopology>(7, false, LLONG_MAX).count(single, &report) == PairEngine<LineTopology>(7, false, LLONG_MAX).count(1));
+    assert(report.nodes == 2 && report.replicas == 0 && report.remoteAccessRatio == -1);
+
+    return 0;
+}
+
+/**
+ * @brief Tests that a thread pool runs every task of a batch exactly once, over many batches.
+ */
+int testThreadPool(){
+    ThreadPool pool(3);
+    assert(pool.size() == 3);
+    for (int tasks : {0, 1, 2, 7, 100}){
+        std::vector<int> runs(tasks, 0);
+        pool.run(tasks, [&](const int t){ runs[t]++; });
+        assert(std::count(runs.begin(), runs.end(), 1) == tasks);
+    }
+    std::vector<long long> sums(4, 0);
+    for (int batch = 0; batch < 200; batch++) pool.run(4, [&](const int t){ sums[t] += batch; });
+    for (long long sum : sums) assert(sum == 199 * 200 / 2);
+    assert(ThreadPool().size() >= 1);
+
+    return 0;
+}
+
+/**
+ * @brief Tests that a session answers like the one-shot searches, and reuses its tables and answers.
+ */
+int testSession(){
+    const std::string testCache = "test_session_cache.tmp";
+    std::remove(testCache.c_str());
+    SessionOptions options;
+    options.threads = 2;
+    options.cacheFile = testCache;
+    {
+        Session session(options);
+        assert(session.threads() == 2);
+        for (int n = 5; n <= 8; n++){
+            QueryResult found = session.query({"line", n, "exists", Bound(0), false});
+            std::vector<int> witness1, witness2;
+            assert(found.exists == findDisjointPaths(n, witness1, witness2));
+            assert(found.witness1 == witness1 && found.witness2 == witness2);
+            found = session.query({"line", n, "within_bound", Bound(16 * (n - 1), 5), false});
+            assert(found.exists == disjointPathsExistWithinBound(n, Bound(16 * (n - 1), 5)));
+            found = session.query({"circle", n, "within_bound", Bound(16 * n, 5), true});
+            witness1.clear();
+            witness2.clear();
+            assert(found.exists == findDisjointCyclesWithinBound(n, Bound(16 * n, 5), witness1, witness2));
+            assert(found.witness1 == witness1 && found.witness2 == witness2);
+
+            assert(session.countPairs({"circle", n, "exists", Bound(0), false}) == countDisjointCycles(n));
+            assert(session.countPairs({"circle", n, "within_bound", Bound(4 * n), true}) == countDisjointCyclesWithinBound(n, Bound(4 * n)));
+
+            long long cost = session.minimumCost("circle", n, false, witness1, witness2);
+            std::vector<int> expected1, expected2;
+            assert(cost == PairEngine<CircleTopology>(n, false, LLONG_MAX).findMinimum(expected1, expected2));
+            assert(witness1 == expected1 && witness2 == expected2);
+        }
+        // Two line and three circle queries per n above; only one line and two circle tables per n.
+        SessionStats stats = session.stats();
+        assert(stats.tourSetsBuilt == 4 * 3 && stats.cacheHits == 0);
+        assert(stats.queries == 4 * 6 && stats.tourSetsReused == stats.queries - stats.tourSetsBuilt);
+
+        QueryResult again = session.query({"circle", 8, "within_bound", Bound(16 * 8, 5), true});
+        assert(session.countPairs({"circle", 8, "exists", Bound(0), false}) == countDisjointCycles(8));
+        assert(session.stats().cacheHits == 2 && session.stats().tourSetsBuilt == stats.tourSetsBuilt);
+        session.releaseTourSets();
+        assert(session.query({"circle", 8, "within_bound", Bound(16 * 8, 5), true}).exists == again.exists);
+        assert(session.stats().tourSetsBuilt == stats.tourSetsBuilt);
+    }
+    {
+        // Concurrent queries on the same tables build them once; the other query waits for them.
+        Session shared(SessionOptions{2, ""});
+        long long counts[2];
+        std::thread other([&](){ counts[1] = shared.countPairs({"circle", 8, "within_bound", Bound(4 * 8), false}); });
+        counts[0] = shared.countPairs({"circle", 8, "exists", Bound(0), false});
+        other.join();
+        assert(counts[0] == countDisjointCycles(8) && counts[1] == PairEngine<CircleTopology>(8, false, 4 * 8 - 1).count(1));
+        assert(shared.stats().tourSetsBuilt == 1 && shared.stats().tourSetsReused == 1);
+    }
+    // A new session finds the answers of the first one in the cache file.
+    Session session(options);
+    QueryResult cached;
+    assert(lookupCachedResult(testCache, {"line", 8, "exists", Bound(0), false}, cached));
+    assert(session.query({"line", 8, "exists", Bound(0), false}).exists == cached.exists);
+    assert(session.stats().cacheHits == 1 && session.stats().tourSetsBuilt == 0);
+    std::remove(testCache.c_str());
+
+    return 0;
+}
+
+/**
+ * @brief Tests the request protocol of the query server, on a stream and on a Unix socket with
+ * concurrent clients.
+ */
+int testQueryServer(){
+    SessionOptions options;
+    options.threads = 2;
+    Session session(options);
+    std::vector<int> witness1, witness2;
+    assert(findDisjointCycles(5, witness1, witness2));
+    std::string expected = "ok exists=1 witness1=" + std::to_string(witness1[0]);
+    assert(answerRequest(session, "exists circle 5").compare(0, expected.size(), expected) == 0);
+    assert(answerRequest(session, "exists line 5").find("ok exists=0 witness1=- witness2=-") == 0);
+    assert(answerRequest(session, "within_bound circle 8 128/5").find("ok exists=0") == 0);
+    assert(answerRequest(session, "count circle 7") == "ok count=" + std::to_string(countDisjointCycles(7)));
+    assert(answerRequest(session, "count circle 7 28") == "ok count=" + std::to_string(countDisjointCyclesWithinBound(7, Bound(28))));
+    assert(answerRequest(session, "min line 4").find("ok cost=-1 ") == 0);
+    for (const char* bad : {"", "hello", "exists square 5", "exists line 2", "exists line 99", "exists line x",
+                            "within_bound line 6", "within_bound line 6 3/0", "count line 6 1 2",
+                            "within_bound line 7 -9223372036854775808", "within_bound line 7 1/9223372036854775807"}){
+        assert(answerRequest(session, bad).find("error") == 0);
+    }
+
+    std::istringstream requests("exists circle 5\n\nstats\r\nquit\nexists line 6\n");
+    std::ostringstream answers;
+    assert(serveStream(session, requests, answers) == 0);
+    std::istringstream lines(answers.str());
+    std::string line;
+    assert(std::getline(lines, line) && line.find("ok exists=1") == 0);
+    assert(std::getline(lines, line) && line.find("ok queries=7 cache_hits=1 ") == 0);
+    assert(!std::getline(lines, line));
+
+    const std::string socketPath = "test_query_server.sock";
+    std::thread server([&](){ assert(serveUnixSocket(session, socketPath) == 0); });
+    std::vector<std::string> reply;
+    for (int attempt = 0; attempt < 100 && !sendRequests(socketPath, {"stats"}, reply); attempt++){
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    assert(reply.size() == 1 && reply[0].find("ok queries=") == 0);
+    std::vector<std::thread> clients;
+    std::vector<std::vector<std::string>> replies(4);
+    for (int c = 0; c < 4; c++){
+        clients.emplace_back([&, c](){
+            std::vector<std::string> batch;
+            for (int n = 4; n <= 8; n++) batch.push_back((c % 2 ? "count circle " : "exists line ") + std::to_string(n));
+            batch.push_back("quit");
+            batch.push_back("exists line 3");
+            assert(sendRequests(socketPath, batch, replies[c]));
+        });
+    }
+    for (std::thread& client : clients) client.join();
+    for (int c = 0; c < 4; c++){
+        assert(replies[c].size() == 5);
+        for (int n = 4; n <= 8; n++){
+            const std::string& answer = replies[c][n - 4];
+            if (c % 2) assert(answer == "ok count=" + std::to_string(countDisjointCycles(n)));
+            else assert(answer.find(disjointPathsExist(n) ? "ok exists=1" : "ok exists=0") == 0);
+        }
+    }
+    assert(sendRequests(socketPath, {"shutdown"}, reply) && reply.empty());
+    server.join();
+    assert(!std::ifstream(socketPath));
+
+    // A file other than a socket at the path is neither removed nor replaced.
+    std::ofstream(socketPath) << "keep me\n";
+    assert(serveUnixSocket(session, socketPath) == 1);
+    std::string kept;
+    assert(std::getline(std::ifstream(socketPath), kept) && kept == "keep me");
+    std::remove(socketPath.c_str());
+
+    return 0;
+}
+
+/**
+ * @brief Tests the overlap matrix against the pairwise reference and the disjointness tests,
+ * and the pool reader.
+ */
+int testOverlapMatrix(){
+    std::mt19937 generator(75);
+    for (bool closed : {true, false}){
+        const int n = 30;
+        std::vector<std::vector<int>> pool;
+        std::vector<int> tour1, tour2;
+        if (closed) constructDisjointCycles(n, tour1, tour2);
+        else constructDisjointPaths(n, tour1, tour2);
+        pool.push_back(tour1);
+        pool.push_back(tour2);
+        pool.push_back(tour1);
+        for (int k = 0; k < 40; k++){
+            std::vector<int> tour = identityTour(n);
+            // Paths keep their endpoints 1 and n; a few random swaps leave some shared edges.
+            for (int swap = 0; swap < (k % 2 ? 3 : n); swap++){
+                std::swap(tour[1 + generator() % (n - 2)], tour[1 + generator() % (n - 2)]);
+            }
+            pool.push_back(tour);
+        }
+
+        OverlapMatrix matrix = computeOverlapMatrix(pool, closed);
+        assert(matrix.tours == (int) pool.size());
+        long long sharedPairs{0};
+        for (int i = 0; i < matrix.tours; i++){
+            assert(matrix.at(i, i) == (closed ? n : n - 1));
+            for (int j = 0; j < matrix.tours; j++){
+                assert(matrix.at(i, j) == matrix.at(j, i) && matrix.at(i, j) == countSharedEdges(pool[i], pool[j], closed));
+                if (i == j) continue;
+                bool disjoint = closed ? areDisjointCycles(pool[i], pool[j]) : areDisjointPaths(pool[i], pool[j]);
+                assert(disjoint == (matrix.at(i, j) == 0));
+                if (i < j) sharedPairs += matrix.at(i, j);
+            }
+        }
+        assert(matrix.at(0, 1) == 0 && matrix.at(0, 2) == (closed ? n : n - 1));
+        assert(matrix.pairUpdates == sharedPairs && matrix.distinctEdges < (long long) pool.size() * n);
+    }
+
+    // Repeated edges count once, labels are arbitrary, and short tours have no edge.
+    OverlapMatrix odd = computeOverlapMatrix({{1, 2, 1, 2}, {2, 1}, {-5, 7, 1000000}, {7, -5}, {3}, {}}, true);
+    assert(odd.at(0, 0) == 1 && odd.at(0, 1) == 1 && odd.at(1, 1) == 1);
+    assert(odd.at(2, 2) == 3 && odd.at(2, 3) == 1 && odd.at(3, 3) == 1);
+    assert(odd.at(4, 4) == 0 && odd.at(5, 5) == 0 && odd.at(2, 4) == 0 && odd.distinctEdges == 4);
+    assert(computeOverlapMatrix({}, true).tours == 0);
+
+    const std::string poolFile = "test_tour_pool.tmp";
+    std::ofstream(poolFile) << "# pool\n1 2 3 4\n\n4 3 1 2\r\n2 4 1 3\n";
+    std::vector<std::vector<int>> read;
+    assert(readTourPoolText(poolFile, read));
+    assert(read == std::vector<std::vector<int>>({{1, 2, 3, 4}, {4, 3, 1, 2}, {2, 4, 1, 3}}));
+    assert(computeOverlapMatrix(read, true).at(0, 1) == 2 && computeOverlapMatrix(read, false).at(0, 2) == 0);
+    std::ofstream(poolFile) << "1 2 3\n1 x 2\n";
+    assert(!readTourPoolText(poolFile, read));
+    std::remove(poolFile.c_str());
+    assert(!readTourPoolText(poolFile, read));
+
+    return 0;
+}
+
 /**
  * @brief Runs all test functions and prints a progress report.
  * The program succeeds only if every assertion passes.
  */
 int main(){
+    // Tests for bound.cpp
+    std::cout << "Bound tests:\n";
+
+    testBound();
+    std::cout << "\tAll tests of testBound function passed.\n";
+    std::cout << "\n";
+
     // Tests for hamiltonian_paths.cpp
     std::cout << "Path tests:\n";
 
@@ -210,6 +1712,10 @@ int main(){
     std::cout << "\tAll tests of testComputeCostPath function passed.\n";
     testArePathsWithinBound();
     std::cout << "\tAll tests of testArePathsWithinBound function passed.\n";
+    testAreDisjointPathsLinear();
+    std::cout << "\tAll tests of testAreDisjointPathsLinear function passed.\n";
+    testPathsBetween();
+    std::cout << "\tAll tests of testPathsBetween function passed.\n";
     std::cout << "\n";
 
     // Tests for hamiltonian_cycles.cpp
@@ -225,6 +1731,146 @@ int main(){
     std::cout << "\tAll tests of testAreCyclesWithinBound function passed.\n";
     testIsOddDepthCycle();
     std::cout << "\tAll tests of testIsOddDepthCycle function passed.\n";
+    testDepthParityChange();
+    std::cout << "\tAll tests of testDepthParityChange function passed.\n";
+    testAreDisjointCyclesLinear();
+    std::cout << "\tAll tests of testAreDisjointCyclesLinear function passed.\n";
+    std::cout << "\n";
+
+    // Tests for lehmer_codes.cpp
+    std::cout << "Encoding tests:\n";
+
+    testEncodeLehmer();
+    std::cout << "\tAll tests of testEncodeLehmer function passed.\n";
+    testDecodeLehmer();
+    std::cout << "\tAll tests of testDecodeLehmer function passed.\n";
+    testTourStore();
+    std::cout << "\tAll tests of testTourStore function passed.\n";
+    std::cout << "\n";
+
+    // Tests for result_cache.cpp
+    std::cout << "Cache tests:\n";
+
+    testQueryKeyString();
+    std::cout << "\tAll tests of testQueryKeyString function passed.\n";
+    testResultCache();
+    std::cout << "\tAll tests of testResultCache function passed.\n";
+    std::cout << "\n";
+
+    // Tests for insertion-based generation and incremental_sweep.cpp
+    std::cout << "Sweep tests:\n";
+
+    testExtendPathsByInsertion();
+    std::cout << "\tAll tests of testExtendPathsByInsertion function passed.\n";
+    testExtendCyclesByInsertion();
+    std::cout << "\tAll tests of testExtendCyclesByInsertion function passed.\n";
+    testSweeps();
+    std::cout << "\tAll tests of testSweeps function passed.\n";
+    std::cout << "\n";
+
+    // Tests for cycle_symmetry.cpp
+    std::cout << "Symmetry tests:\n";
+
+    testTransformCycle();
+    std::cout << "\tAll tests of testTransformCycle function passed.\n";
+    testPairOrbits();
+    std::cout << "\tAll tests of testPairOrbits function passed.\n";
+    std::cout << "\n";
+
+    // Tests for tour_stream.cpp
+    std::cout << "Stream tests:\n";
+
+    testTourStream();
+    std::cout << "\tAll tests of testTourStream function passed.\n";
+    std::cout << "\n";
+
+    // Tests for constructions.cpp
+    std::cout << "Construction tests:\n";
+
+    testConstructions();
+    std::cout << "\tAll tests of testConstructions function passed.\n";
+    std::cout << "\n";
+
+    // Tests for local_search.cpp and annealing.cpp
+    std::cout << "Heuristic tests:\n";
+
+    testLocalSearch();
+    std::cout << "\tAll tests of testLocalSearch function passed.\n";
+    testAnnealing();
+    std::cout << "\tAll tests of testAnnealing function passed.\n";
+    std::cout << "\n";
+
+    // Tests for anytime_search.cpp
+    std::cout << "Anytime search tests:\n";
+
+    testAnytimeSearch();
+    std::cout << "\tAll tests of testAnytimeSearch function passed.\n";
+    std::cout << "\n";
+
+    // Tests for certificate_writer.cpp and certificate_checker.cpp
+    std::cout << "Certificate tests:\n";
+
+    testCertificates();
+    std::cout << "\tAll tests of testCertificates function passed.\n";
+    std::cout << "\n";
+
+    // Tests for pair_engine.h
+    std::cout << "Pair engine tests:\n";
+
+    testPairEngine();
+    std::cout << "\tAll tests of testPairEngine function passed.\n";
+    std::cout << "\n";
+
+    // Tests for distance_matrix.cpp
+    std::cout << "Distance matrix tests:\n";
+
+    testDistanceMatrix();
+    std::cout << "\tAll tests of testDistanceMatrix function passed.\n";
+    testArcDisjointTours();
+    std::cout << "\tAll tests of testArcDisjointTours function passed.\n";
+    std::cout << "\n";
+
+    // Tests for cost_histogram.cpp and pair_counting.cpp
+    std::cout << "Counting tests:\n";
+
+    testCostHistograms();
+    std::cout << "\tAll tests of testCostHistograms function passed.\n";
+    testInclusionExclusion();
+    std::cout << "\tAll tests of testInclusionExclusion function passed.\n";
+    std::cout << "\n";
+
+    // Tests for tour_arena.cpp and huge_pages.cpp
+    std::cout << "Memory tests:\n";
+
+    testTourArena();
+    std::cout << "\tAll tests of testTourArena function passed.\n";
+    testHugePages();
+    std::cout << "\tAll tests of testHugePages function passed.\n";
+    std::cout << "\n";
+
+    // Tests for numa_placement.cpp
+    std::cout << "Parallel placement tests:\n";
+
+    testNumaPlacement();
+    std::cout << "\tAll tests of testNumaPlacement function passed.\n";
+    std::cout << "\n";
+
+    // Tests for thread_pool.cpp, session.cpp and query_server.cpp
+    std::cout << "Session tests:\n";
+
+    testThreadPool();
+    std::cout << "\tAll tests of testThreadPool function passed.\n";
+    testSession();
+    std::cout << "\tAll tests of testSession function passed.\n";
+    testQueryServer();
+    std::cout << "\tAll tests of testQueryServer function passed.\n";
+    std::cout << "\n";
+
+    // Tests for tour_overlap.cpp
+    std::cout << "Overlap tests:\n";
+
+    testOverlapMatrix();
+    std::cout << "\tAll tests of testOverlapMatrix function passed.\n";
     std::cout << "\n";
 
     return 0;